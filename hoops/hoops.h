@@ -65,6 +65,16 @@ namespace hoops {
     PP_FORCE_PROMPT = 1,
     PP_DEFAULT = PP_NONE
   };
+
+  // Kind of value a parameter holds, as given by its type field.
+  enum ParTypeCode_e {
+    PT_UNKNOWN = 0,
+    PT_BOOL = 1,
+    PT_INT = 2,
+    PT_REAL = 3,
+    PT_STRING = 4,
+    PT_FILE = 5
+  };
   //////////////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////////////
@@ -84,15 +94,22 @@ namespace hoops {
       virtual IPar & operator =(const short & p) = 0;
       virtual IPar & operator =(const int & p) = 0;
       virtual IPar & operator =(const long & p) = 0;
+      // By default, long long values are assigned and converted by way of
+      // long, and those which long cannot hold throw P_OVERFLOW or
+      // P_UNDERFLOW. Par converts them directly.
+      virtual IPar & operator =(const long long & p) { From(p); return *this; }
       virtual IPar & operator =(const unsigned char & p) = 0;
       virtual IPar & operator =(const unsigned short & p) = 0;
       virtual IPar & operator =(const unsigned int & p) = 0;
       virtual IPar & operator =(const unsigned long & p) = 0;
+      virtual IPar & operator =(const unsigned long long & p) { From(p); return *this; }
       virtual IPar & operator =(const float & p) = 0;
       virtual IPar & operator =(const double & p) = 0;
       virtual IPar & operator =(const long double & p) = 0;
       virtual IPar & operator =(const char * p) = 0;
       virtual IPar & operator =(const std::string & p) = 0;
+      // Overridden to take over p's buffer where that saves a copy.
+      virtual IPar & operator =(std::string && p) { return operator =(p); }
 
       // Conversion operators.
       virtual operator bool () const = 0;
@@ -101,10 +118,12 @@ namespace hoops {
       virtual operator short () const = 0;
       virtual operator int () const = 0;
       virtual operator long () const = 0;
+      virtual operator long long () const { long long p = 0; To(p); return p; }
       virtual operator unsigned char () const = 0;
       virtual operator unsigned short () const = 0;
       virtual operator unsigned int () const = 0;
       virtual operator unsigned long () const = 0;
+      virtual operator unsigned long long () const { unsigned long long p = 0; To(p); return p; }
       virtual operator float () const = 0;
       virtual operator double () const = 0;
       virtual operator long double () const = 0;
@@ -120,15 +139,18 @@ namespace hoops {
       virtual void From(const short & p) = 0;
       virtual void From(const int & p) = 0;
       virtual void From(const long & p) = 0;
+      virtual void From(const long long & p);
       virtual void From(const unsigned char & p) = 0;
       virtual void From(const unsigned short & p) = 0;
       virtual void From(const unsigned int & p) = 0;
       virtual void From(const unsigned long & p) = 0;
+      virtual void From(const unsigned long long & p);
       virtual void From(const float & p) = 0;
       virtual void From(const double & p) = 0;
       virtual void From(const long double & p) = 0;
       virtual void From(const char * p) = 0;
       virtual void From(const std::string & p) = 0;
+      virtual void From(std::string && p) { From(p); }
 
       // Conversions to other objects.
       virtual void To(bool & p) const = 0;
@@ -137,20 +159,44 @@ namespace hoops {
       virtual void To(short & p) const = 0;
       virtual void To(int & p) const = 0;
       virtual void To(long & p) const = 0;
+      virtual void To(long long & p) const;
       virtual void To(unsigned char & p) const = 0;
       virtual void To(unsigned short & p) const = 0;
       virtual void To(unsigned int & p) const = 0;
       virtual void To(unsigned long & p) const = 0;
+      virtual void To(unsigned long long & p) const;
       virtual void To(float & p) const = 0;
       virtual void To(double & p) const = 0;
       virtual void To(long double & p) const = 0;
       virtual void To(std::string & p) const = 0;
 
+      // Like To, but return the HexceptionCode_e, including warnings, instead
+      // of throwing it or reporting it to the WarningSink. By default these
+      // catch what To throws.
+      virtual HexceptionCode_e TryTo(bool & p) const { return CatchCode([&] { To(p); }); }
+      virtual HexceptionCode_e TryTo(char & p) const { return CatchCode([&] { To(p); }); }
+      virtual HexceptionCode_e TryTo(signed char & p) const { return CatchCode([&] { To(p); }); }
+      virtual HexceptionCode_e TryTo(short & p) const { return CatchCode([&] { To(p); }); }
+      virtual HexceptionCode_e TryTo(int & p) const { return CatchCode([&] { To(p); }); }
+      virtual HexceptionCode_e TryTo(long & p) const { return CatchCode([&] { To(p); }); }
+      virtual HexceptionCode_e TryTo(long long & p) const { return CatchCode([&] { To(p); }); }
+      virtual HexceptionCode_e TryTo(unsigned char & p) const { return CatchCode([&] { To(p); }); }
+      virtual HexceptionCode_e TryTo(unsigned short & p) const { return CatchCode([&] { To(p); }); }
+      virtual HexceptionCode_e TryTo(unsigned int & p) const { return CatchCode([&] { To(p); }); }
+      virtual HexceptionCode_e TryTo(unsigned long & p) const { return CatchCode([&] { To(p); }); }
+      virtual HexceptionCode_e TryTo(unsigned long long & p) const { return CatchCode([&] { To(p); }); }
+      virtual HexceptionCode_e TryTo(float & p) const { return CatchCode([&] { To(p); }); }
+      virtual HexceptionCode_e TryTo(double & p) const { return CatchCode([&] { To(p); }); }
+      virtual HexceptionCode_e TryTo(long double & p) const { return CatchCode([&] { To(p); }); }
+      virtual HexceptionCode_e TryTo(std::string & p) const { return CatchCode([&] { To(p); }); }
+
       virtual IPar * Clone() const = 0;
 
       // Member access.
       virtual const std::string & Name() const = 0;
       virtual const std::string & Type() const = 0;
+      // By default, ParseTypeCode(Type()).
+      virtual ParTypeCode_e TypeCode() const;
       virtual const std::string & Mode() const = 0;
       virtual const std::string & Value() const = 0;
       virtual const std::string & Min() const = 0;
@@ -160,6 +206,12 @@ namespace hoops {
       virtual const IPrim * PrimValue() const = 0;
       virtual int Status() const = 0;
 
+      // True if the value was assigned since the parameter was created or
+      // last marked unmodified, e.g. by saving it. By default parameters are
+      // always treated as modified, so that saving never skips them.
+      virtual bool IsModified() const { return true; }
+      virtual IPar & SetModified(bool = true) { return *this; }
+
       virtual IPar & SetName(const std::string & s) = 0;
       virtual IPar & SetType(const std::string & s) = 0;
       virtual IPar & SetMode(const std::string & s) = 0;
@@ -189,12 +241,56 @@ namespace hoops {
       virtual IParGroup & Remove(IPar * p) = 0;
       virtual IParGroup & Remove(const std::string & pname) = 0;
 
+      // Value which changes whenever parameters are added to or removed from
+      // the group. Values are never reused, even by another group. By
+      // default it changes on every call, which is always safe, though it
+      // makes ParHandle find the parameter on every use.
+      virtual unsigned long Generation() const { return NextGeneration(); }
+
       virtual GenParItor begin() = 0;
       virtual ConstGenParItor begin() const = 0;
       virtual GenParItor end() = 0;
       virtual ConstGenParItor end() const = 0;
 
       virtual IParGroup * Clone() const = 0;
+
+    protected:
+      // A value for Generation which no group has used.
+      static unsigned long NextGeneration();
+  };
+
+  // Handle to a named parameter in a group, for code which uses the same
+  // parameter repeatedly. The parameter is found once, and the handle then
+  // refers to it directly until the group's Generation changes, when it is
+  // found again by name on next use. The group must outlive the handle.
+  class EXPSYM ParHandle {
+    public:
+      ParHandle(): mGroup(0), mPar(0), mGeneration(0), mName() {}
+      ParHandle(const IParGroup & group, const std::string & pname): mGroup(&group),
+        mPar(&group.Find(pname)), mGeneration(group.Generation()), mName(pname) {}
+
+      IPar & operator *() const { return Resolve(); }
+      IPar * operator ->() const { return &Resolve(); }
+
+      // Return the parameter, finding it again if the group has changed.
+      // Throws PAR_NOT_FOUND if it has since been removed.
+      IPar & Resolve() const {
+        if (0 == mGroup)
+          throw Hexception(PAR_NULL_PTR, "Use of a ParHandle which does not refer to a group", __FILE__, __LINE__);
+        if (mGroup->Generation() != mGeneration) {
+          mPar = &mGroup->Find(mName);
+          mGeneration = mGroup->Generation();
+        }
+        return *mPar;
+      }
+
+      const std::string & Name() const { return mName; }
+
+    private:
+      const IParGroup * mGroup;
+      mutable IPar * mPar;
+      mutable unsigned long mGeneration;
+      std::string mName;
   };
 
   class EXPSYM IParFile {
@@ -296,6 +392,10 @@ namespace hoops {
   // Function declarations.
   //////////////////////////////////////////////////////////////////////////////
   EXPSYM std::ostream & operator <<(std::ostream & os, const IPar & p);
+
+  // Classify a parameter type field. A type may combine a kind with access
+  // letters, so "fr" (readable file) is a file, not a real.
+  EXPSYM ParTypeCode_e ParseTypeCode(const std::string & type);
   //////////////////////////////////////////////////////////////////////////////
 
 }
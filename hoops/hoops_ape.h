@@ -16,6 +16,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include "hoops/hoops.h"
 #include "hoops/hoops_exception.h"
+#include <memory>
 #include <string>
 #include <vector>
 ////////////////////////////////////////////////////////////////////////////////
@@ -47,23 +48,70 @@ namespace hoops {
   class ApeException : public Hexception {
     public:
       ApeException(const int & code, const std::string & msg,
-                   const std::string & filename = std::string(), int line = 0);
+                   const char * filename = 0, int line = 0);
+      ApeException(const int & code, const std::string & msg,
+                   const std::string & filename, int line = 0);
       int ApeCode() const;
 
     protected:
+      virtual void format(std::string & text) const override;
       static int ape2Hoops(int status);
       int mApeCode;
   };
 
+  // One opening of a component's parameter file through ape, shared by the
+  // HoopsApeFile and HoopsApePrompt objects which use it, so that loading,
+  // prompting and saving do not each reopen and reparse the file. Changes
+  // reach the file only when Commit is called. Ape keeps only one current
+  // file, so opening a session closes whichever other session is open, and
+  // the evicted session reopens itself when next used. Closing discards
+  // the evicted session's changes, but HoopsApeFile never leaves any there
+  // which it would otherwise write: Load commits command line values at
+  // once, and answers to prompts reach the file through the group on Save.
+  class EXPSYM HoopsApeSession {
+    public:
+      // Note: argv[0] is the component (tool) name, as for ape_trad_init.
+      HoopsApeSession(const std::string & comp, int argc, char ** argv);
+      ~HoopsApeSession();
+
+      // Open the file unless this session is already the open one.
+      void Open();
+
+      // Write ape's copy of the parameters to the file and close it.
+      void Commit();
+
+      // Close the file without writing it.
+      void Close();
+
+      bool IsOpen() const { return this == sCurrent; }
+      const std::string & Component() const { return mComponent; }
+
+    private:
+      HoopsApeSession(const HoopsApeSession &);
+      HoopsApeSession & operator =(const HoopsApeSession &);
+
+      std::string mComponent;
+      std::vector<std::string> mArg;
+      std::vector<char *> mArgv;
+      static HoopsApeSession * sCurrent;
+  };
+
+  // Copies of a HoopsApeFile share its session, as does the file of a
+  // HoopsApePrompt made from it. Load commits the session if there are
+  // command line arguments, so that ape learns them as it always has, and
+  // otherwise leaves it open. Prompt leaves the session open, and Save
+  // commits it.
   class EXPSYM HoopsApeFile : public IParFile {
     public:
       HoopsApeFile(const HoopsApeFile & pf);
+      HoopsApeFile(HoopsApeFile && pf) noexcept;
       HoopsApeFile(const IParFile & pf);
       HoopsApeFile(const std::string & comp, int argc = 0, char ** argv = 0);
 
       virtual ~HoopsApeFile();
 
       virtual HoopsApeFile & operator =(const HoopsApeFile & pf);
+      HoopsApeFile & operator =(HoopsApeFile && pf) noexcept;
       virtual HoopsApeFile & operator =(const IParFile & pf);
 
       // Synchronize memory image with parameter file and vice versa.
@@ -97,6 +145,10 @@ namespace hoops {
       mutable IParGroup * mGroup;
       int mArgc;
       char ** mArgv;
+      mutable std::shared_ptr<HoopsApeSession> mSession;
+      // True if the group was loaded or last saved by this file, so ape holds
+      // the values of its unmodified parameters.
+      mutable bool mSynced;
       void CleanComponent(const std::string & comp, std::string & clean) const;
   };
 
@@ -117,6 +169,7 @@ namespace hoops {
 
       virtual int Argc() const { return mFile->Argc(); }
       virtual char ** const Argv() const { return mFile->Argv(); }
+      const HoopsApeFile & File() const { return *mFile; }
       virtual IParGroup & Group();
       virtual const IParGroup & Group() const;
 
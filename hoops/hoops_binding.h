@@ -0,0 +1,155 @@
+/******************************************************************************
+ *   File name: hoops_binding.h                                               *
+ *                                                                            *
+ * Description: Binding of the parameters in a group to the members of a      *
+ *     user structure, for filling the structure in one call.                 *
+ *                                                                            *
+ *    Language: C++                                                           *
+ *                                                                            *
+ *      Author: hoops package maintainers (see SConscript)                    *
+ *                                                                            *
+ *  Change log: see CVS Change log at the end of the file.                    *
+ ******************************************************************************/
+#ifndef HOOPS_BINDING_H
+#define HOOPS_BINDING_H
+////////////////////////////////////////////////////////////////////////////////
+// C++ header files.
+////////////////////////////////////////////////////////////////////////////////
+#include "hoops/hoops.h"
+#include "hoops/hoops_exception.h"
+#include "hoops/hoops_par.h"
+#include <string>
+#include <variant>
+#include <vector>
+////////////////////////////////////////////////////////////////////////////////
+
+namespace hoops {
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Constants.
+  //////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Type declarations/definitions.
+  //////////////////////////////////////////////////////////////////////////////
+  // Binding of named parameters to members of a structure S. Bind each
+  // parameter once, then Resolve looks the names up in a group, once. After
+  // that, Read fills an S from the group and Write copies an S back into it,
+  // each in one pass over the bound parameters with no name lookups:
+  //
+  //   struct Args { double mRa; long mNumBins; std::string mInFile; };
+  //   ParBinding<Args> binding;
+  //   binding.Bind("ra", &Args::mRa).Bind("nbins", &Args::mNumBins).Bind("infile", &Args::mInFile);
+  //   binding.Resolve(group);
+  //   Args args;
+  //   binding.Read(args);
+  //
+  // Values are converted as by IPar's To and From, so Read and Write throw
+  // the same exceptions they would. Resolve throws PAR_NOT_FOUND if a name
+  // is not in the group. Like a ParHandle, Read and Write find the
+  // parameters again by themselves when the group's Generation changes, so
+  // the group must outlive the binding.
+  template <typename S>
+  class ParBinding {
+    public:
+      typedef std::variant<bool S::*, char S::*, signed char S::*, short S::*, int S::*, long S::*,
+        long long S::*, unsigned char S::*, unsigned short S::*, unsigned int S::*, unsigned long S::*,
+        unsigned long long S::*, float S::*, double S::*, long double S::*, std::string S::*> Member_t;
+
+      ParBinding(): mSlots(), mGroup(0), mGeneration(0) {}
+
+      // Bind the named parameter to member. Bindings made after Resolve take
+      // effect when Resolve is next called.
+      template <typename T>
+      ParBinding & Bind(const std::string & pname, T S::* member) {
+        Slot slot = { pname, Member_t(member), 0, 0 };
+        mSlots.push_back(slot);
+        mGroup = 0;
+        return *this;
+      }
+
+      // Find every bound parameter in group. Write changes the group, so
+      // it is taken by non-const reference.
+      ParBinding & Resolve(IParGroup & group) { FindAll(group); return *this; }
+
+      // Copy every bound parameter into its member of s.
+      void Read(S & s) const {
+        Refresh();
+        for (typename Container_t::const_iterator it = mSlots.begin(); it != mSlots.end(); ++it) {
+          const Slot & slot = *it;
+          std::visit([&slot, &s](auto member) { ReadValue(slot, s.*member); }, slot.mMember);
+        }
+      }
+
+      // Copy every bound member of s into its parameter.
+      void Write(const S & s) const {
+        Refresh();
+        for (typename Container_t::const_iterator it = mSlots.begin(); it != mSlots.end(); ++it) {
+          const Slot & slot = *it;
+          std::visit([&slot, &s](auto member) { WriteValue(slot, s.*member); }, slot.mMember);
+        }
+      }
+
+      std::size_t size() const { return mSlots.size(); }
+
+    private:
+      struct Slot {
+        std::string mName;
+        Member_t mMember;
+        IPar * mPar;
+        Par * mFastPar;
+      };
+      typedef std::vector<Slot> Container_t;
+
+      template <typename T>
+      static void ReadValue(const Slot & slot, T & value) {
+        if (0 != slot.mFastPar) value = slot.mFastPar->template Get<T>();
+        else slot.mPar->To(value);
+      }
+
+      template <typename T>
+      static void WriteValue(const Slot & slot, const T & value) {
+        if (0 != slot.mFastPar) slot.mFastPar->Set(value);
+        else slot.mPar->From(value);
+      }
+
+      void FindAll(IParGroup & group) const {
+        mGroup = 0;
+        for (typename Container_t::iterator it = mSlots.begin(); it != mSlots.end(); ++it) {
+          it->mPar = &group.Find(it->mName);
+          // The concrete Par is read and written without virtual calls.
+          it->mFastPar = dynamic_cast<Par *>(it->mPar);
+        }
+        // Finding the parameters may itself change the generation.
+        mGroup = &group;
+        mGeneration = group.Generation();
+      }
+
+      void Refresh() const {
+        if (0 == mGroup)
+          throw Hexception(PAR_NULL_PTR, "ParBinding used before Resolve", __FILE__, __LINE__);
+        if (mGroup->Generation() != mGeneration) FindAll(*mGroup);
+      }
+
+      mutable Container_t mSlots;
+      mutable IParGroup * mGroup;
+      mutable unsigned long mGeneration;
+  };
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Global variable forward declarations.
+  //////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Function declarations.
+  //////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////////////////////////////////////////////////
+
+}
+#endif
+
+/******************************************************************************
+ ******************************************************************************/
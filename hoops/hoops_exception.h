@@ -65,22 +65,37 @@ namespace hoops {
   //////////////////////////////////////////////////////////////////////////////
   // Type declarations/definitions.
   //////////////////////////////////////////////////////////////////////////////
+  // Exceptions are thrown routinely, e.g. by refused conversions, so
+  // throwing one only records the code, message and location; the text
+  // returned by what() is formatted the first time it is called. Thus
+  // the same object must not be used by several threads at once. Messages
+  // are copied, except that an empty one, as the conversions give, needs
+  // no copy. A file name given as const char * must outlive the exception,
+  // e.g. __FILE__; one given as std::string is copied.
   class EXPSYM Hexception: public std::exception {
     public:
       Hexception(const int & code, const std::string & msg = std::string(),
-                 const std::string & filename = std::string(), int line = 0);
+                 const char * filename = 0, int line = 0);
+      Hexception(const int & code, const std::string & msg, const std::string & filename,
+                 int line = 0);
+      Hexception(const int & code, const char * msg, const char * filename = 0,
+                 int line = 0);
       virtual ~Hexception() throw() {}
 
       int Code() const { return mCode; }
-      const std::string & Msg() const { return mMsg; }
+      const std::string & Msg() const { what(); return mText; }
       virtual const char * what() const throw();
 
     protected:
-      Hexception(const int & code, const std::string & filename = std::string(),
-                 int line = 0);
-      virtual void format(const std::string & msg);
+      // Format the text returned by what().
+      virtual void format(std::string & text) const;
+      void formatMsg(std::string & text) const;
+      void formatLocation(std::string & text) const;
       std::string mMsg;
-      std::string mFileName;
+      mutable std::string mText;
+      const char * mFileName;
+      // Copy of a file name given as std::string, used if mFileName is 0.
+      std::string mFileNameCopy;
       int mCode;
       int mLine;
   };
@@ -89,6 +104,32 @@ namespace hoops {
   //////////////////////////////////////////////////////////////////////////////
   // Type declarations/definitions.
   //////////////////////////////////////////////////////////////////////////////
+  // Destination of conversion warnings: P_BADSIZE, P_PRECISION and
+  // P_SIGNEDNESS, which mean the value was converted and stored, but might
+  // not equal the source. By default the throwing conversions (From, To,
+  // Get, Set, assignment and cast operators) count warnings and call the
+  // handler, if any, instead of throwing them. SetThrow(true) makes them
+  // throw warnings as they do any other code. The Try forms always return
+  // them. Settings and counts belong to the calling thread.
+  class EXPSYM WarningSink {
+    public:
+      typedef void (*Handler_t)(int code, void * data);
+
+      static bool IsWarning(int code)
+        { return P_BADSIZE == code || P_PRECISION == code || P_SIGNEDNESS == code; }
+
+      static bool Throws();
+      static void SetThrow(bool throw_warnings);
+      static void SetHandler(Handler_t handler, void * data = 0);
+      // Number of warnings with the given code since the last ClearCounts,
+      // whether or not they were thrown.
+      static unsigned long Count(int code);
+      static void ClearCounts();
+
+      // Used by conversions: return true if code is a warning and has been
+      // reported here, or false if it should be thrown.
+      static bool Take(int code);
+  };
   //////////////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////////////
@@ -99,6 +140,25 @@ namespace hoops {
   //////////////////////////////////////////////////////////////////////////////
   // Function declarations.
   //////////////////////////////////////////////////////////////////////////////
+  // Call convert() and return the code of any Hexception it throws, with
+  // warnings thrown rather than reported for the duration. This is how the
+  // default Try members of the interfaces use the throwing forms.
+  template <typename Convert_t>
+  inline HexceptionCode_e CatchCode(Convert_t convert) {
+    bool throws = WarningSink::Throws();
+    WarningSink::SetThrow(true);
+    HexceptionCode_e status = P_OK;
+    try {
+      convert();
+    } catch (const Hexception & x) {
+      status = HexceptionCode_e(x.Code());
+    } catch (...) {
+      WarningSink::SetThrow(throws);
+      throw;
+    }
+    WarningSink::SetThrow(throws);
+    return status;
+  }
   //////////////////////////////////////////////////////////////////////////////
 
 }
@@ -15,7 +15,13 @@
 // C++ header files.
 ////////////////////////////////////////////////////////////////////////////////
 #include "hoops/hoops.h"
+#include <cstddef>
+#include <iosfwd>
+#include <iterator>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -43,14 +49,64 @@ namespace hoops {
   //////////////////////////////////////////////////////////////////////////////
   // Type declarations/definitions.
   //////////////////////////////////////////////////////////////////////////////
+  // Standard parameter group. Each group owns its parameters. Copying a
+  // group clones them, but a Par shares its fields and value with its clone
+  // until either is changed, and the copy shares the name index, so no
+  // strings are copied.
   class EXPSYM ParGroup : public IParGroup {
     public:
       typedef std::vector<IPar *> Container_t;
       typedef BiDirItor<IPar *, Container_t::iterator> Itor_t;
       typedef ConstBiDirItor<IPar *, Container_t::const_iterator> ConstItor_t;
+      typedef std::unordered_map<std::string, Container_t::size_type> Index_t;
+
+      // Iterator over the parameters of a ParGroup which needs no allocation
+      // or virtual calls, unlike GenParItor. P is IPar or const IPar.
+      template <typename P>
+      class RangeItor {
+        public:
+          typedef std::bidirectional_iterator_tag iterator_category;
+          typedef P value_type;
+          typedef std::ptrdiff_t difference_type;
+          typedef P * pointer;
+          typedef P & reference;
+
+          RangeItor(): mPos(0) {}
+          explicit RangeItor(IPar * const * pos): mPos(pos) {}
+
+          P & operator *() const { return **mPos; }
+          P * operator ->() const { return *mPos; }
+          RangeItor & operator ++() { ++mPos; return *this; }
+          RangeItor operator ++(int) { RangeItor r(*this); ++mPos; return r; }
+          RangeItor & operator --() { --mPos; return *this; }
+          RangeItor operator --(int) { RangeItor r(*this); --mPos; return r; }
+          bool operator ==(const RangeItor & other) const { return mPos == other.mPos; }
+          bool operator !=(const RangeItor & other) const { return mPos != other.mPos; }
+
+        private:
+          IPar * const * mPos;
+      };
+
+      template <typename P>
+      class Range {
+        public:
+          typedef RangeItor<P> Itor_t;
+          Range(Itor_t begin, Itor_t end): mBegin(begin), mEnd(end) {}
+          Itor_t begin() const { return mBegin; }
+          Itor_t end() const { return mEnd; }
+
+        private:
+          Itor_t mBegin;
+          Itor_t mEnd;
+      };
+
+      typedef Range<IPar> Range_t;
+      typedef Range<const IPar> ConstRange_t;
 
       ParGroup(const std::string & comp_name);
       ParGroup(const ParGroup & g);
+      // The moved-from group is left empty.
+      ParGroup(ParGroup && g) noexcept;
 
       virtual ~ParGroup();
 
@@ -58,6 +114,8 @@ namespace hoops {
 
       virtual ParGroup & operator =(const ParGroup & g);
 
+      ParGroup & operator =(ParGroup && g) noexcept;
+
       virtual IPar & operator [](const std::string & pname) const
         { return Find(pname); }
 
@@ -66,6 +124,7 @@ namespace hoops {
       virtual ParGroup & Add(IPar * p);
       virtual ParGroup & Remove(IPar * p);
       virtual ParGroup & Remove(const std::string & pname);
+      virtual unsigned long Generation() const { return mGeneration; }
       virtual GenParItor begin()
         { return GenParItor(Itor_t(mPars.begin())); }
       virtual ConstGenParItor begin() const
@@ -75,11 +134,107 @@ namespace hoops {
       virtual ConstGenParItor end() const
         { return ConstGenParItor(ConstItor_t(mPars.end())); }
 
+      // The parameters, for range-for loops:
+      //   for (const IPar & par : group.Pars()) ...
+      // Iterators are valid until parameters are added or removed.
+      Range_t Pars()
+        { return Range_t(Range_t::Itor_t(mPars.data()), Range_t::Itor_t(mPars.data() + mPars.size())); }
+      ConstRange_t Pars() const {
+        return ConstRange_t(ConstRange_t::Itor_t(mPars.data()),
+          ConstRange_t::Itor_t(mPars.data() + mPars.size()));
+      }
+
       virtual ParGroup * Clone() const { return new ParGroup(*this); }
 
     private:
+      friend class Par;
+      friend class SharedParGroup;
+
+      void Copy(const ParGroup & g);
+      void Own(IPar * p);
+      Container_t::size_type Position(const std::string & pname) const;
+      void Reindex();
+
       Container_t mPars;
+      // Name index used by Find; mPars alone determines iteration order.
+      // Copies of a group share it, so it is replaced rather than changed
+      // while shared. Null if it has not been built. Only changes to the
+      // group update it, never Find, so const groups may be read by several
+      // threads at once.
+      std::shared_ptr<Index_t> mIndex;
+      // A Par reindexes the group which owns it when renamed, so mIndex holds
+      // the first parameter of each name, unless the group holds parameters
+      // of other types (mForeign), which may be renamed without notice.
+      bool mForeign;
       std::string mGroupName;
+      unsigned long mGeneration;
+      // Snapshots of a SharedParGroup are never changed, so never reindex.
+      bool mFrozen;
+  };
+
+  // Read-only view of one version of a SharedParGroup, which stays valid for
+  // as long as it is held. Copies refer to the same version. Parameters can
+  // only be reached as const, so the version can only be replaced, through
+  // the SharedParGroup, never changed.
+  class EXPSYM ParSnapshot {
+    public:
+      const IPar & operator [](const std::string & pname) const
+        { return mGroup->Find(pname); }
+
+      const IPar & Find(const std::string & pname) const
+        { return mGroup->Find(pname); }
+
+      // The parameters, for range-for loops:
+      //   for (const IPar & par : snapshot.Pars()) ...
+      ParGroup::ConstRange_t Pars() const { return mGroup->Pars(); }
+
+    private:
+      friend class SharedParGroup;
+
+      explicit ParSnapshot(const std::shared_ptr<const ParGroup> & group): mGroup(group) {}
+
+      std::shared_ptr<const ParGroup> mGroup;
+  };
+
+  // Parameter group shared between threads. Readers take a Snapshot, an
+  // immutable copy of the group which stays valid for as long as they hold
+  // it, without locking. Writers publish a new version with Publish or
+  // Update; readers see it from their next Snapshot, and existing snapshots
+  // are unaffected. Writers are serialized with each other, but never block
+  // readers.
+  //
+  // A snapshot and its parameters may be used from any number of threads.
+  class EXPSYM SharedParGroup {
+    public:
+      typedef ParSnapshot Snapshot_t;
+
+      SharedParGroup(const IParGroup & group);
+      virtual ~SharedParGroup();
+
+      // The current version of the group.
+      Snapshot_t Snapshot() const;
+
+      // Replace the group with a copy of group.
+      void Publish(const IParGroup & group);
+
+      // Apply update to a copy of the current version, then publish the copy.
+      template <typename Update_t>
+      void Update(Update_t update) {
+        std::lock_guard<std::mutex> lock(mWriteMutex);
+        std::shared_ptr<ParGroup> next(new ParGroup(*Current()));
+        update(*next);
+        Store(next);
+      }
+
+    private:
+      SharedParGroup(const SharedParGroup &);
+      SharedParGroup & operator =(const SharedParGroup &);
+
+      std::shared_ptr<const ParGroup> Current() const;
+      void Store(const std::shared_ptr<ParGroup> & group);
+
+      std::shared_ptr<const ParGroup> mCurrent;
+      std::mutex mWriteMutex;
   };
 
   //////////////////////////////////////////////////////////////////////////////
@@ -92,6 +247,13 @@ namespace hoops {
   //////////////////////////////////////////////////////////////////////////////
   // Function declarations.
   //////////////////////////////////////////////////////////////////////////////
+  // Binary form of a group. Values are stored in the type Par holds them in,
+  // so reading needs no parsing. The format is only meant to be read on the
+  // platform which wrote it, e.g. for caching; ReadBinary throws
+  // PAR_FILE_CORRUPT for anything else, and leaves the group unchanged.
+  EXPSYM void WriteBinary(std::ostream & os, const IParGroup & group);
+  EXPSYM void ReadBinary(std::istream & is, IParGroup & group);
+  EXPSYM void ReadBinary(const char * begin, const char * end, IParGroup & group);
   //////////////////////////////////////////////////////////////////////////////
 
 }
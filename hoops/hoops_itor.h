@@ -92,6 +92,8 @@ namespace hoops {
       GenBiDirItor(): IBiDirItor<T>(), mItor(0) {}
       GenBiDirItor(const GenBiDirItor & other): IBiDirItor<T>(), mItor(0)
         { if (other.mItor) mItor = other.mItor->Clone(); }
+      GenBiDirItor(GenBiDirItor && other) noexcept: IBiDirItor<T>(), mItor(other.mItor)
+        { other.mItor = 0; }
       GenBiDirItor(const IBiDirItor<T> & other): IBiDirItor<T>(), mItor(0)
         { mItor = other.Clone(); }
 
@@ -104,6 +106,15 @@ namespace hoops {
         return *this;
       }
 
+      GenBiDirItor & operator =(GenBiDirItor && other) noexcept {
+        if (this != &other) {
+          delete mItor;
+          mItor = other.mItor;
+          other.mItor = 0;
+        }
+        return *this;
+      }
+
       virtual GenBiDirItor & operator =(const IBiDirItor<T> & other) {
         delete mItor;
         mItor = other.Clone();
@@ -187,6 +198,8 @@ namespace hoops {
       ConstGenBiDirItor(): IConstBiDirItor<T>(), mItor(0) {}
       ConstGenBiDirItor(const ConstGenBiDirItor & other): IConstBiDirItor<T>(), mItor(0)
         { if (other.mItor) mItor = other.mItor->Clone(); }
+      ConstGenBiDirItor(ConstGenBiDirItor && other) noexcept: IConstBiDirItor<T>(), mItor(other.mItor)
+        { other.mItor = 0; }
       ConstGenBiDirItor(const IConstBiDirItor<T> & other): IConstBiDirItor<T>(), mItor(0)
         { mItor = other.Clone(); }
 
@@ -199,6 +212,15 @@ namespace hoops {
         return *this;
       }
 
+      ConstGenBiDirItor & operator =(ConstGenBiDirItor && other) noexcept {
+        if (this != &other) {
+          delete mItor;
+          mItor = other.mItor;
+          other.mItor = 0;
+        }
+        return *this;
+      }
+
       virtual ConstGenBiDirItor & operator =(const IConstBiDirItor<T> & other) {
         delete mItor;
         mItor = other.Clone();
@@ -1,8 +1,8 @@
 /******************************************************************************
  *   File name: hoops_limits.h                                                *
  *                                                                            *
- * Description: Encapsulation of machine-dependent numeric limits,            *
- *     needed because of variations in the implementations of <limits>.       *
+ * Description: Compile-time properties of the primitive types, extending     *
+ *     std::numeric_limits.                                                   *
  *                                                                            *
  *    Language: C++                                                           *
  *                                                                            *
@@ -16,7 +16,8 @@
 ////////////////////////////////////////////////////////////////////////////////
 // C++ header files.
 ////////////////////////////////////////////////////////////////////////////////
-#include "hoops/hoops_numeric_limits.h"
+#include <limits>
+#include <type_traits>
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace hoops {
@@ -68,7 +69,9 @@ namespace hoops {
     P_VOID_P        = POINTER_TYPE,
     P_UNKNOWN       = 0,
     P_LONGLONG      = SIGNED_TYPE | EXTENDED_TYPE,
-    P_LONGLONG_P    = SIGNED_TYPE | EXTENDED_TYPE | POINTER_TYPE
+    P_LONGLONG_P    = SIGNED_TYPE | EXTENDED_TYPE | POINTER_TYPE,
+    P_ULONGLONG     = UNSIGNED_TYPE | EXTENDED_TYPE,
+    P_ULONGLONG_P   = UNSIGNED_TYPE | EXTENDED_TYPE | POINTER_TYPE
   };
   //////////////////////////////////////////////////////////////////////////////
 
@@ -77,93 +80,73 @@ namespace hoops {
   //////////////////////////////////////////////////////////////////////////////
   // Template class Lim, which contains the necessary information to
   // assess compatibility of different numeric types. Note that T
-  // must be a fundamental primitive type: bool, char, etc.
+  // must be a fundamental primitive type: bool, char, etc. Everything
+  // in Lim is constexpr, so conversions can decide which checks they
+  // need at compile time.
   //////////////////////////////////////////////////////////////////////////////
   template <typename T>
-#ifdef HAVE_LIMITS
   class Lim : public std::numeric_limits<T> {
-#else
-  class Lim : public hoops::numeric_limits<T> {
-#endif
     public:
-      inline static bool is_smaller_than(PrimTypeCode_e typecode) throw () {
+      static constexpr bool is_smaller_than(PrimTypeCode_e typecode) noexcept {
+        // Type bool is considered smaller than all other types, regardless
+        // of how the actual sizes compare.
+        if (std::is_same<T, bool>::value) return P_BOOL != typecode;
         switch (typecode) {
-          case P_BOOL: return sizeof(T) < sizeof(bool); break;
-          case P_CHAR: return sizeof(T) < sizeof(char); break;
-          case P_SCHAR: return sizeof(T) < sizeof(signed char); break;
-          case P_SHORT: return sizeof(T) < sizeof(short); break;
-          case P_INT: return sizeof(T) < sizeof(int); break;
-          case P_LONG: return sizeof(T) < sizeof(long); break;
-          case P_UCHAR: return sizeof(T) < sizeof(unsigned char); break;
-          case P_USHORT: return sizeof(T) < sizeof(unsigned short); break;
-          case P_UINT: return sizeof(T) < sizeof(unsigned int); break;
-          case P_ULONG: return sizeof(T) < sizeof(unsigned long); break;
-          case P_FLOAT: return sizeof(T) < sizeof(float); break;
-          case P_DOUBLE: return sizeof(T) < sizeof(double); break;
-          case P_LONGDOUBLE: return sizeof(T) < sizeof(long double); break;
+          case P_BOOL: return sizeof(T) < sizeof(bool);
+          case P_CHAR: return sizeof(T) < sizeof(char);
+          case P_SCHAR: return sizeof(T) < sizeof(signed char);
+          case P_SHORT: return sizeof(T) < sizeof(short);
+          case P_INT: return sizeof(T) < sizeof(int);
+          case P_LONG: return sizeof(T) < sizeof(long);
+          case P_UCHAR: return sizeof(T) < sizeof(unsigned char);
+          case P_USHORT: return sizeof(T) < sizeof(unsigned short);
+          case P_UINT: return sizeof(T) < sizeof(unsigned int);
+          case P_ULONG: return sizeof(T) < sizeof(unsigned long);
+          case P_FLOAT: return sizeof(T) < sizeof(float);
+          case P_DOUBLE: return sizeof(T) < sizeof(double);
+          case P_LONGDOUBLE: return sizeof(T) < sizeof(long double);
+          case P_LONGLONG: return sizeof(T) < sizeof(long long);
+          case P_ULONGLONG: return sizeof(T) < sizeof(unsigned long long);
           default: break;
         }
         return false;
       }
 
-      // Note that maybe_smaller_than is defined for all types,
-      // but it is only valid when applied to integral types.
-      static bool maybe_smaller_than(PrimTypeCode_e typecode) throw ()
-        { return false; }
-
-      static PrimTypeCode_e GetCode() { return code; }
+      // Whether T is smaller than the type with the given code on some
+      // platform, judging only by the ranks the language guarantees:
+      // bool < char < short < int < long < long long. Note that
+      // maybe_smaller_than is defined for all types, but it is only valid
+      // when applied to integral types.
+      static constexpr bool maybe_smaller_than(PrimTypeCode_e typecode) noexcept {
+        bool long_long = P_LONGLONG == typecode || P_ULONGLONG == typecode;
+        if (!std::numeric_limits<T>::is_integer) return false;
+        else if (0 != (BOOL_TYPE & GetCode())) return P_BOOL != typecode;
+        else if (0 != (CHAR_TYPE & GetCode())) return 0 == ((BOOL_TYPE | CHAR_TYPE) & typecode);
+        else if (0 != (SHORT_TYPE & GetCode())) return long_long || 0 != ((INT_TYPE | LONG_TYPE) & typecode);
+        else if (0 != (INT_TYPE & GetCode())) return long_long || 0 != (LONG_TYPE & typecode);
+        else if (0 != (LONG_TYPE & GetCode())) return long_long;
+        return false;
+      }
 
-    private:
-      static PrimTypeCode_e code;
+      static constexpr PrimTypeCode_e GetCode() noexcept {
+        if (std::is_same<T, bool>::value) return P_BOOL;
+        else if (std::is_same<T, char>::value) return P_CHAR;
+        else if (std::is_same<T, signed char>::value) return P_SCHAR;
+        else if (std::is_same<T, short>::value) return P_SHORT;
+        else if (std::is_same<T, int>::value) return P_INT;
+        else if (std::is_same<T, long>::value) return P_LONG;
+        else if (std::is_same<T, unsigned char>::value) return P_UCHAR;
+        else if (std::is_same<T, unsigned short>::value) return P_USHORT;
+        else if (std::is_same<T, unsigned int>::value) return P_UINT;
+        else if (std::is_same<T, unsigned long>::value) return P_ULONG;
+        else if (std::is_same<T, float>::value) return P_FLOAT;
+        else if (std::is_same<T, double>::value) return P_DOUBLE;
+        else if (std::is_same<T, long double>::value) return P_LONGDOUBLE;
+        else if (std::is_same<T, long long>::value) return P_LONGLONG;
+        else if (std::is_same<T, unsigned long long>::value) return P_ULONGLONG;
+        return P_UNKNOWN;
+      }
   };
-
-  // Template class Lim specializations.
-  //////////////////////////////////////////////////////////////////////////////
-
-  // Type bool is considered smaller than all other types, regardless
-  // of how the actual sizes compare.
-  template <>
-  inline bool Lim<bool>::is_smaller_than(PrimTypeCode_e typecode) throw ()
-    { return P_BOOL != typecode; }
-
-  // Type bool is considered smaller than all other types, regardless
-  // of how the actual sizes compare.
-  template <>
-  inline bool Lim<bool>::maybe_smaller_than(PrimTypeCode_e typecode) throw ()
-    { return P_BOOL != typecode; }
-
-  template <>
-  inline bool Lim<char>::maybe_smaller_than(PrimTypeCode_e typecode) throw ()
-    { return 0 == ((BOOL_TYPE | CHAR_TYPE) & typecode); }
-
-  template <>
-  inline bool Lim<signed char>::maybe_smaller_than(PrimTypeCode_e typecode)
-      throw ()
-    { return 0 == ((BOOL_TYPE | CHAR_TYPE) & typecode); }
-
-  template <>
-  inline bool Lim<short>::maybe_smaller_than(PrimTypeCode_e typecode) throw ()
-    { return 0 != ((INT_TYPE | LONG_TYPE) & typecode); }
-
-  template <>
-  inline bool Lim<int>::maybe_smaller_than(PrimTypeCode_e typecode) throw ()
-    { return 0 != (LONG_TYPE & typecode); }
-
-  template <>
-  inline bool Lim<unsigned char>::maybe_smaller_than(PrimTypeCode_e typecode)
-      throw ()
-    { return 0 == ((BOOL_TYPE | CHAR_TYPE) & typecode); }
-
-  template <>
-  inline bool Lim<unsigned short>::maybe_smaller_than(PrimTypeCode_e typecode)
-      throw ()
-    { return 0 != ((INT_TYPE | LONG_TYPE) & typecode); }
-
-  template <>
-  inline bool Lim<unsigned int>::maybe_smaller_than(PrimTypeCode_e typecode)
-      throw ()
-    { return 0 != (LONG_TYPE & typecode); }
-
   //////////////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////////////
@@ -15,7 +15,10 @@
 ////////////////////////////////////////////////////////////////////////////////
 // C++ header files.
 ////////////////////////////////////////////////////////////////////////////////
+#include <atomic>
+#include <memory>
 #include <string>
+#include <utility>
 #include "hoops/hoops.h"
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -43,11 +46,18 @@ namespace hoops {
   //////////////////////////////////////////////////////////////////////////////
   // Type declarations/definitions.
   //////////////////////////////////////////////////////////////////////////////
+  class ParGroup;
+
+  // Standard parameter. Copies of a Par share its fields and value until
+  // one of them is changed, so copying a Par, and hence a ParGroup, need not
+  // copy any strings. Each copy is still a separate object, which may be
+  // changed without affecting the others.
   class EXPSYM Par : public IPar {
     public:
       // Constructors.
       Par();
       Par(const Par & p);
+      Par(Par && p) noexcept;
       Par(const IPar & p);
       Par(const std::string & name, const std::string & type,
           const std::string & mode, const std::string & value,
@@ -80,6 +90,8 @@ namespace hoops {
          { From(p); return *this; }
       virtual Par & operator =(const long & p)
          { From(p); return *this; }
+      virtual Par & operator =(const long long & p)
+         { From(p); return *this; }
       virtual Par & operator =(const unsigned char & p)
         { From(p); return *this; }
       virtual Par & operator =(const unsigned short & p)
@@ -88,6 +100,8 @@ namespace hoops {
         { From(p); return *this; }
       virtual Par & operator =(const unsigned long & p)
         { From(p); return *this; }
+      virtual Par & operator =(const unsigned long long & p)
+        { From(p); return *this; }
       virtual Par & operator =(const float & p)
         { From(p); return *this; }
       virtual Par & operator =(const double & p)
@@ -98,6 +112,8 @@ namespace hoops {
         { From(p); return *this; }
       virtual Par & operator =(const std::string & p)
         { From(p); return *this; }
+      virtual Par & operator =(std::string && p)
+        { From(std::move(p)); return *this; }
 
       virtual void From(const IPar & p);
       virtual void From(const IPrim & p);
@@ -107,15 +123,18 @@ namespace hoops {
       virtual void From(const short & p);
       virtual void From(const int & p);
       virtual void From(const long & p);
+      virtual void From(const long long & p);
       virtual void From(const unsigned char & p);
       virtual void From(const unsigned short & p);
       virtual void From(const unsigned int & p);
       virtual void From(const unsigned long & p);
+      virtual void From(const unsigned long long & p);
       virtual void From(const float & p);
       virtual void From(const double & p);
       virtual void From(const long double & p);
       virtual void From(const char * p);
       virtual void From(const std::string & p);
+      virtual void From(std::string && p);
 
       // Conversions.
       virtual operator bool () const;
@@ -124,10 +143,12 @@ namespace hoops {
       virtual operator short () const;
       virtual operator int () const;
       virtual operator long () const;
+      virtual operator long long () const;
       virtual operator unsigned char () const;
       virtual operator unsigned short () const;
       virtual operator unsigned int () const;
       virtual operator unsigned long () const;
+      virtual operator unsigned long long () const;
       virtual operator float () const;
       virtual operator double () const;
       virtual operator long double () const;
@@ -140,105 +161,223 @@ namespace hoops {
       virtual void To(short & p) const;
       virtual void To(int & p) const;
       virtual void To(long & p) const;
+      virtual void To(long long & p) const;
       virtual void To(unsigned char & p) const;
       virtual void To(unsigned short & p) const;
       virtual void To(unsigned int & p) const;
       virtual void To(unsigned long & p) const;
+      virtual void To(unsigned long long & p) const;
       virtual void To(float & p) const;
       virtual void To(double & p) const;
       virtual void To(long double & p) const;
       virtual void To(std::string & p) const;
 
+      virtual HexceptionCode_e TryTo(bool & p) const;
+      virtual HexceptionCode_e TryTo(char & p) const;
+      virtual HexceptionCode_e TryTo(signed char & p) const;
+      virtual HexceptionCode_e TryTo(short & p) const;
+      virtual HexceptionCode_e TryTo(int & p) const;
+      virtual HexceptionCode_e TryTo(long & p) const;
+      virtual HexceptionCode_e TryTo(long long & p) const;
+      virtual HexceptionCode_e TryTo(unsigned char & p) const;
+      virtual HexceptionCode_e TryTo(unsigned short & p) const;
+      virtual HexceptionCode_e TryTo(unsigned int & p) const;
+      virtual HexceptionCode_e TryTo(unsigned long & p) const;
+      virtual HexceptionCode_e TryTo(unsigned long long & p) const;
+      virtual HexceptionCode_e TryTo(float & p) const;
+      virtual HexceptionCode_e TryTo(double & p) const;
+      virtual HexceptionCode_e TryTo(long double & p) const;
+      virtual HexceptionCode_e TryTo(std::string & p) const;
+
+      // Non-virtual access to the value. When T is the type in which the
+      // value is held (bool, PrimUnion::Long_t, double or std::string,
+      // according to the parameter type), Get is a plain load and Set a plain store; other
+      // types go through Par's own To and From. Overrides of To and From in
+      // derived classes are not called.
+      template <typename T>
+      T Get() const {
+        const Body & body = *mBody;
+        if (P_OK == body.mStatus && body.mHasValue) {
+          if (const T * value = body.mValue.GetIf<T>()) return *value;
+        }
+        T r; Par::To(r); return r;
+      }
+
+      template <typename T>
+      Par & Set(const T & p) {
+        Body & body = Edit();
+        if (T * value = body.mHasValue ? body.mValue.GetIf<T>() : 0) {
+          *value = p;
+          body.mStatus = P_OK;
+          mModified = true;
+          body.mValStringValid = false;
+        } else {
+          Par::From(p);
+        }
+        return *this;
+      }
+
+      Par & Set(std::string && p) {
+        Body & body = Edit();
+        if (std::string * value = body.mHasValue ? body.mValue.GetIf<std::string>() : 0) {
+          *value = std::move(p);
+          body.mStatus = P_OK;
+          mModified = true;
+          body.mValStringValid = false;
+        } else {
+          Par::From(std::move(p));
+        }
+        return *this;
+      }
+
       virtual Par * Clone() const
         { return new Par(*this); }
 
       // Member access.
-      virtual const std::string & Name() const { return mName; }
-      virtual const std::string & Type() const { return mType; }
-      virtual const std::string & Mode() const { return mMode; }
+      virtual const std::string & Name() const { return mBody->mName; }
+      virtual const std::string & Type() const { return mBody->mType; }
+      virtual ParTypeCode_e TypeCode() const { return mBody->mTypeCode; }
+      virtual const std::string & Mode() const { return mBody->mMode; }
       virtual const std::string & Value() const;
       virtual const std::string & Min() const
-        { return mMin; }
+        { return mBody->mMin; }
       virtual const std::string & Max() const
-        { return mMax; }
-      virtual const std::string & Prompt() const { return mPrompt; }
-      virtual const std::string & Comment() const { return mComment; }
-      virtual const IPrim * PrimValue() const { return mValue; }
-      virtual int Status() const { return mStatus; }
-
-      virtual Par & SetName(const std::string & s)
-        { mName = s; return *this; }
+        { return mBody->mMax; }
+      virtual const std::string & Prompt() const { return mBody->mPrompt; }
+      virtual const std::string & Comment() const { return mBody->mComment; }
+      virtual const IPrim * PrimValue() const { return mBody->mHasValue ? &mBody->mValue : 0; }
+      virtual int Status() const { return mBody->mStatus; }
+      virtual bool IsModified() const { return mModified; }
+      virtual Par & SetModified(bool modified = true)
+        { mModified = modified; return *this; }
+
+      virtual Par & SetName(const std::string & s);
       virtual Par & SetType(const std::string & s)
-        { mType = s; return *this; }
+        { Body & body = Edit(); body.mType = s; body.mTypeCode = ParseTypeCode(s); return *this; }
       virtual Par & SetMode(const std::string & s)
-        { mMode = s; return *this; }
+        { Edit().mMode = s; return *this; }
       virtual Par & SetValue(const std::string & s)
         { From(s); return *this; }
       virtual Par & SetMin(const std::string & s)
-        { mMin = s; return *this; }
+        { Edit().mMin = s; return *this; }
       virtual Par & SetMax(const std::string & s)
-        { mMax = s; return *this; }
+        { Edit().mMax = s; return *this; }
       virtual Par & SetPrompt(const std::string & s)
-        { mPrompt = s; return *this; }
+        { Edit().mPrompt = s; return *this; }
       virtual Par & SetComment(const std::string & s)
-        { mComment = s; return *this; }
+        { Edit().mComment = s; return *this; }
 
     protected:
       template <typename T>
-      void ConvertFrom(T p, IPrim *& dest, const std::string & type) {
-        PrimFactory Factory;
-        // Make a copy of the primitive as a string.
-        IPrim * prim_string = Factory.NewIPrim(std::string());
-        if (0 != prim_string) {
-          prim_string->From(p);
-          prim_string->To(mValString);
-        }
-
+      void ConvertFrom(T p) {
         try {
-          if (dest) dest->From(p);
-          // In general is find the best thing to be using here???
-          else if (std::string::npos != type.find("b")) {
-            dest = Factory.NewIPrim(bool()); dest->From(p);
-          } else if (std::string::npos != type.find("i")) {
-            dest = Factory.NewIPrim(long()); dest->From(p);
-          // Important to check for type "f" before "r", because "fr" is
-          // file readable. If we check first for "r", such a parameter
-          // is misclassified as a float (double) value.
-          } else if (std::string::npos != type.find("f") ||
-            std::string::npos != type.find("s")) {
-            dest = Factory.NewIPrim(std::string()); dest->From(p);
-          } else if (std::string::npos != type.find("r")) {
-            dest = Factory.NewIPrim(double()); dest->From(p);
-          } else throw Hexception(PAR_INVALID_TYPE,
-            std::string("Don't know how to handle parameters of type ") + type, __FILE__, __LINE__);
-          mStatus = P_OK;
+          // The value is held in place, in the type chosen by the first
+          // assignment. The string form is rendered only when requested.
+          Body & body = Edit();
+          body.mValStringValid = false;
+          if (!body.mHasValue) { body.mValue.SetType(PrimType()); body.mHasValue = true; }
+          body.mValue.From(std::forward<T>(p));
+          body.mStatus = P_OK;
+          mModified = true;
         } catch (const Hexception & x) {
+          // Even when it throws, the conversion may have stored a value:
+          // always for warnings, and e.g. the limit of the type on overflow.
+          // Treat the parameter as changed, so that Save does not skip it.
           int status = x.Code();
-          if (P_INFINITE == status || P_UNDEFINED == status) mStatus = status;
+          mModified = true;
+          if (P_INFINITE == status || P_UNDEFINED == status) {
+            Edit().mStatus = status;
+            KeepSpecialValue(p);
+          } else if (WarningSink::IsWarning(status)) {
+            Edit().mStatus = P_OK;
+          }
           throw;
         }
       }
 
       template <typename T>
-      void ConvertTo (IPrim * const src, T & p) const {
-        if (P_INFINITE == mStatus)
+      void ConvertTo (T & p) const {
+        HexceptionCode_e status = TryConvertTo(p);
+        if (P_INFINITE == status)
           throw Hexception(P_INFINITE, "Attempt to convert infinite parameter to value", __FILE__, __LINE__);
-        else if (P_UNDEFINED == mStatus)
+        else if (P_UNDEFINED == status)
           throw Hexception(P_UNDEFINED, "Attempt to convert undefined parameter to value", __FILE__, __LINE__);
-        if (src) src->To(p); else p = T();
+        else if (P_OK != status && !WarningSink::Take(status))
+          throw Hexception(status, "", __FILE__, __LINE__);
+      }
+
+      template <typename T>
+      HexceptionCode_e TryConvertTo (T & p) const {
+        const Body & body = *mBody;
+        if (P_INFINITE == body.mStatus) return P_INFINITE;
+        else if (P_UNDEFINED == body.mStatus) return P_UNDEFINED;
+        if (body.mHasValue) return body.mValue.TryTo(p);
+        p = T();
+        return P_OK;
       }
 
     private:
-      std::string mName;
-      std::string mType;
-      std::string mMode;
-      IPrim * mValue;
-      std::string mMin;
-      std::string mMax;
-      std::string mPrompt;
-      std::string mComment;
-      mutable std::string mValString;
-      int mStatus;
+      friend class ParGroup;
+
+      // Everything but the modified flag, shared by copies of a Par until one
+      // of them is changed. A shared body is never changed, not even its
+      // cached string, so it must be rendered before it is shared.
+      struct Body {
+        Body();
+        Body(const std::string & name, const std::string & type, const std::string & mode,
+          const std::string & min, const std::string & max, const std::string & prompt,
+          const std::string & comment);
+
+        std::string mName;
+        std::string mType;
+        ParTypeCode_e mTypeCode;
+        std::string mMode;
+        PrimUnion mValue;
+        bool mHasValue;
+        std::string mMin;
+        std::string mMax;
+        std::string mPrompt;
+        std::string mComment;
+        // The value rendered as a string, computed on first request after
+        // each change of the value and reused until the next.
+        std::string mValString;
+        bool mValStringValid;
+        int mStatus;
+      };
+
+      // Body shared by default constructed and moved-from Pars.
+      static const std::shared_ptr<Body> & EmptyBody();
+
+      // The body, for changing it, copied first if other Pars share it.
+      Body & Edit() {
+        if (1 != mBody.use_count()) Unshare();
+        // use_count is a relaxed load. Other Pars, perhaps in other threads,
+        // finished using the body before releasing it; the fence orders the
+        // caller's changes after their use.
+        else std::atomic_thread_fence(std::memory_order_acquire);
+        return *mBody;
+      }
+      void Unshare();
+
+      PrimUnion::Type_e PrimType() const;
+
+      template <typename T>
+      void FromString(T p);
+
+      // Infinite and undefined values cannot be rendered from the primitive,
+      // so keep their exact text. Other sources cannot produce these values.
+      void KeepSpecialValue(const std::string & p)
+        { Body & body = Edit(); body.mValString = p; body.mValStringValid = true; }
+      void KeepSpecialValue(const IPrim & p)
+        { Body & body = Edit(); p.To(body.mValString); body.mValStringValid = true; }
+      template <typename T>
+      void KeepSpecialValue(const T &) {}
+
+      std::shared_ptr<Body> mBody;
+      bool mModified;
+      // Group which holds this parameter, reindexed by SetName. Copies
+      // belong to no group until one adds them.
+      ParGroup * mOwner;
   };
 
   class EXPSYM ParFactory : public IParFactory {
@@ -0,0 +1,226 @@
+/******************************************************************************
+ *   File name: hoops_par_file.h                                              *
+ *                                                                            *
+ * Description: Native parameter file which reads and writes the text format  *
+ *     directly, without going through an external library.                   *
+ *                                                                            *
+ *    Language: C++                                                           *
+ *                                                                            *
+ *      Author: hoops package maintainers (see SConscript)                    *
+ *                                                                            *
+ *  Change log: see CVS Change log at the end of the file.                    *
+ ******************************************************************************/
+#ifndef HOOPS_PAR_FILE_H
+#define HOOPS_PAR_FILE_H
+////////////////////////////////////////////////////////////////////////////////
+// C++ header files.
+////////////////////////////////////////////////////////////////////////////////
+#include "hoops/hoops.h"
+#include "hoops/hoops_exception.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef EXPSYM
+#ifdef WIN32
+
+#ifndef SCons
+#define EXPSYM __declspec(dllexport)
+#else
+#define EXPSYM
+#endif
+
+#else
+#define EXPSYM
+#endif
+#endif
+
+namespace hoops {
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Constants.
+  //////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Type declarations/definitions.
+  //////////////////////////////////////////////////////////////////////////////
+  // Fields of one line of a parameter file, as views of the file's text with
+  // any quotes removed. Comment lines and blank lines have an empty name, and
+  // the whole line as their comment.
+  class EXPSYM ParLineView {
+    public:
+      enum Field_e { eName, eType, eMode, eValue, eMin, eMax, ePrompt, eComment, eNumField };
+
+      std::string_view Name() const { return mField[eName]; }
+      std::string_view Type() const { return mField[eType]; }
+      std::string_view Mode() const { return mField[eMode]; }
+      std::string_view Value() const { return mField[eValue]; }
+      std::string_view Min() const { return mField[eMin]; }
+      std::string_view Max() const { return mField[eMax]; }
+      std::string_view Prompt() const { return mField[ePrompt]; }
+      std::string_view Comment() const { return mField[eComment]; }
+
+      // Create a parameter holding copies of these fields.
+      IPar * NewPar() const;
+
+      std::string_view mField[eNumField];
+  };
+
+  // Read-only contents of a file, memory mapped where the platform allows, or
+  // else read into one buffer.
+  class EXPSYM MappedFile {
+    public:
+      MappedFile(const std::string & file_name);
+      ~MappedFile();
+
+      const char * Data() const { return mData; }
+      std::size_t Size() const { return mSize; }
+
+    private:
+      MappedFile(const MappedFile &);
+      MappedFile & operator =(const MappedFile &);
+
+      std::string mBuffer;
+      const char * mData;
+      std::size_t mSize;
+      bool mMapped;
+  };
+
+  // Read-only image of a parameter file. The file is memory mapped where the
+  // platform allows (otherwise read into one buffer), and parsed in one pass
+  // into views of its text, so no strings are allocated. Strings are created
+  // only when the lines are copied into a parameter group by Load. The views
+  // are valid for as long as the ParFileMap exists.
+  class EXPSYM ParFileMap {
+    public:
+      typedef std::vector<ParLineView> Container_t;
+      typedef Container_t::const_iterator ConstItor_t;
+
+      ParFileMap(const std::string & file_name);
+      ~ParFileMap();
+
+      // Find the first line defining the named parameter, or return 0.
+      // This is a linear search, which avoids building an index.
+      const ParLineView * Find(std::string_view pname) const;
+
+      // Add a parameter for every line to group.
+      void Load(IParGroup & group) const;
+
+      const std::string & FileName() const { return mFileName; }
+      ConstItor_t begin() const { return mLines.begin(); }
+      ConstItor_t end() const { return mLines.end(); }
+      std::size_t size() const { return mLines.size(); }
+
+      // Parse the text in [begin, end) into views, appended to lines.
+      static void Parse(const char * begin, const char * end, Container_t & lines);
+
+    private:
+      ParFileMap(const ParFileMap &);
+      ParFileMap & operator =(const ParFileMap &);
+
+      std::string mFileName;
+      MappedFile mFile;
+      Container_t mLines;
+  };
+
+  // Parameter file in the traditional name,type,mode,value,min,max,prompt
+  // format. Lines which do not define a parameter (comments and blank lines)
+  // are kept as nameless parameters whose comment is the whole line, so that
+  // Save reproduces them. Command line arguments and prompting are not handled
+  // here; use HoopsApeFile/HoopsApePrompt for those.
+  class EXPSYM HoopsParFile : public IParFile {
+    public:
+      HoopsParFile(const HoopsParFile & pf);
+      HoopsParFile(HoopsParFile && pf) noexcept;
+      HoopsParFile(const IParFile & pf);
+      HoopsParFile(const std::string & comp, const std::string & file_name = std::string());
+
+      virtual ~HoopsParFile();
+
+      virtual HoopsParFile & operator =(const HoopsParFile & pf);
+      HoopsParFile & operator =(HoopsParFile && pf) noexcept;
+      virtual HoopsParFile & operator =(const IParFile & pf);
+
+      // Synchronize memory image with parameter file and vice versa.
+      virtual void Load();
+      virtual void Save() const;
+
+      // Read member access.
+      virtual const std::string & Component() const { return mComponent; }
+      virtual IParGroup & Group();
+      virtual const IParGroup & Group() const;
+
+      // File read by Load and written by Save. If not set explicitly, it is
+      // found by searching PFILES for the component's .par file.
+      const std::string & FileName() const { return mFileName; }
+
+      // Write member access.
+      virtual HoopsParFile & SetComponent(const std::string & comp);
+      virtual IParGroup * SetGroup(IParGroup * group = 0);
+      HoopsParFile & SetFileName(const std::string & file_name);
+
+      virtual GenParItor begin();
+      virtual ConstGenParItor begin() const;
+      virtual GenParItor end();
+      virtual ConstGenParItor end() const;
+
+      virtual IParFile * Clone() const;
+
+      // Parse the contents of a parameter file held in memory into group.
+      // Any parameters already in group are kept.
+      static void Parse(const char * begin, const char * end, IParGroup & group);
+
+    protected:
+      std::string FindParFile() const;
+      std::string UserParFile() const;
+
+      std::string mComponent;
+      std::string mFileName;
+      mutable IParGroup * mGroup;
+  };
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Global variable forward declarations.
+  //////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Function declarations.
+  //////////////////////////////////////////////////////////////////////////////
+  // Find the component's .par file in the PFILES directories, or in the
+  // current directory if PFILES is not set. Returns an empty string if the
+  // file does not exist.
+  EXPSYM std::string LocateParFile(const std::string & comp);
+
+  // Every copy of the component's .par file which ape may read: the first
+  // found in the user directories of PFILES (those before ';'), then the
+  // first found in the system directories (those after it), if different.
+  // Empty if PFILES is not set, since ape then looks elsewhere.
+  EXPSYM std::vector<std::string> LocateParFiles(const std::string & comp);
+
+  // Binary cache of the group read from one or more parameter files, kept
+  // next to the first of them. The cache is used only if the files' paths,
+  // modification times and sizes match those recorded when the cache was
+  // written; otherwise ReadParCache returns false and leaves group unchanged.
+  // WriteParCache fails silently, since the cache is only an optimization
+  // (e.g. a system directory may be read-only). RemoveParCache discards the
+  // cache, for when a file is about to change.
+  EXPSYM bool ReadParCache(const std::vector<std::string> & par_files, IParGroup & group);
+  EXPSYM void WriteParCache(const std::vector<std::string> & par_files, const IParGroup & group);
+  EXPSYM void RemoveParCache(const std::vector<std::string> & par_files);
+
+  // Cache of a single parameter file.
+  EXPSYM bool ReadParCache(const std::string & par_file, IParGroup & group);
+  EXPSYM void WriteParCache(const std::string & par_file, const IParGroup & group);
+  EXPSYM void RemoveParCache(const std::string & par_file);
+  //////////////////////////////////////////////////////////////////////////////
+
+}
+#endif
+
+/******************************************************************************
+ ******************************************************************************/
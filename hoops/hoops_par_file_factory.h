@@ -0,0 +1,68 @@
+/******************************************************************************
+ *   File name: hoops_par_file_factory.h                                      *
+ *                                                                            *
+ * Description: Declaration of factory to create native parameter files.      *
+ *                                                                            *
+ *    Language: C++                                                           *
+ *                                                                            *
+ *      Author: hoops package maintainers (see SConscript)                    *
+ *                                                                            *
+ *  Change log: see CVS Change log at the end of the file.                    *
+ ******************************************************************************/
+#ifndef HOOPS_PAR_FILE_FACTORY_H
+#define HOOPS_PAR_FILE_FACTORY_H
+////////////////////////////////////////////////////////////////////////////////
+// C++ header files.
+////////////////////////////////////////////////////////////////////////////////
+#include "hoops/hoops.h"
+#include <string>
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef EXPSYM
+#ifdef WIN32
+
+#ifndef SCons
+#define EXPSYM __declspec(dllexport)
+#else
+#define EXPSYM
+#endif
+
+#else
+#define EXPSYM
+#endif
+#endif
+
+namespace hoops {
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Constants.
+  //////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Type declarations/definitions.
+  //////////////////////////////////////////////////////////////////////////////
+  class EXPSYM HoopsParFileFactory : public IParFileFactory {
+    public:
+      virtual ~HoopsParFileFactory() {}
+
+      virtual IParFile * NewIParFile(const IParFile & p);
+      virtual IParFile * NewIParFile(const std::string & comp_name);
+  };
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Global variable forward declarations.
+  //////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Function declarations.
+  //////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////////////////////////////////////////////////
+
+}
+#endif
+
+/******************************************************************************
+ ******************************************************************************/
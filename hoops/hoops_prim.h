@@ -19,6 +19,9 @@
 #include <cctype>
 #include <iosfwd>
 #include <string>
+#include <type_traits>
+#include <variant>
+#include "hoops/hoops_exception.h"
 ////////////////////////////////////////////////////////////////////////////////
 
 #ifndef EXPSYM
@@ -47,10 +50,14 @@ namespace hoops {
       virtual void From(const signed short & x) = 0;
       virtual void From(const signed int & x) = 0;
       virtual void From(const signed long & x) = 0;
+      // By default, long long values are converted by way of long, and those
+      // which long cannot hold throw P_OVERFLOW or P_UNDERFLOW.
+      virtual void From(const signed long long & x);
       virtual void From(const unsigned char & x) = 0;
       virtual void From(const unsigned short & x) = 0;
       virtual void From(const unsigned int & x) = 0;
       virtual void From(const unsigned long & x) = 0;
+      virtual void From(const unsigned long long & x);
       virtual void From(const float & x) = 0;
       virtual void From(const double & x) = 0;
       virtual void From(const long double & x) = 0;
@@ -63,15 +70,58 @@ namespace hoops {
       virtual void To(signed short & x) const = 0;
       virtual void To(signed int & x) const = 0;
       virtual void To(signed long & x) const = 0;
+      virtual void To(signed long long & x) const;
       virtual void To(unsigned char & x) const = 0;
       virtual void To(unsigned short & x) const = 0;
       virtual void To(unsigned int & x) const = 0;
       virtual void To(unsigned long & x) const = 0;
+      virtual void To(unsigned long long & x) const;
       virtual void To(float & x) const = 0;
       virtual void To(double & x) const = 0;
       virtual void To(long double & x) const = 0;
       virtual void To(std::string & x) const = 0;
 
+      // Status-returning forms of From/To: the value is converted exactly as
+      // by From/To, but the HexceptionCode_e is returned instead of thrown.
+      // Warnings are returned too, rather than reported to the WarningSink.
+      // By default these catch what From/To throw; override them to avoid
+      // the cost of the exception.
+      virtual HexceptionCode_e TryFrom(const IPrim & x) { return CatchCode([&] { From(x); }); }
+      virtual HexceptionCode_e TryFrom(const bool & x) { return CatchCode([&] { From(x); }); }
+      virtual HexceptionCode_e TryFrom(const char & x) { return CatchCode([&] { From(x); }); }
+      virtual HexceptionCode_e TryFrom(const signed char & x) { return CatchCode([&] { From(x); }); }
+      virtual HexceptionCode_e TryFrom(const signed short & x) { return CatchCode([&] { From(x); }); }
+      virtual HexceptionCode_e TryFrom(const signed int & x) { return CatchCode([&] { From(x); }); }
+      virtual HexceptionCode_e TryFrom(const signed long & x) { return CatchCode([&] { From(x); }); }
+      virtual HexceptionCode_e TryFrom(const signed long long & x) { return CatchCode([&] { From(x); }); }
+      virtual HexceptionCode_e TryFrom(const unsigned char & x) { return CatchCode([&] { From(x); }); }
+      virtual HexceptionCode_e TryFrom(const unsigned short & x) { return CatchCode([&] { From(x); }); }
+      virtual HexceptionCode_e TryFrom(const unsigned int & x) { return CatchCode([&] { From(x); }); }
+      virtual HexceptionCode_e TryFrom(const unsigned long & x) { return CatchCode([&] { From(x); }); }
+      virtual HexceptionCode_e TryFrom(const unsigned long long & x) { return CatchCode([&] { From(x); }); }
+      virtual HexceptionCode_e TryFrom(const float & x) { return CatchCode([&] { From(x); }); }
+      virtual HexceptionCode_e TryFrom(const double & x) { return CatchCode([&] { From(x); }); }
+      virtual HexceptionCode_e TryFrom(const long double & x) { return CatchCode([&] { From(x); }); }
+      virtual HexceptionCode_e TryFrom(const std::string & x) { return CatchCode([&] { From(x); }); }
+
+      virtual HexceptionCode_e TryTo(IPrim & x) const { return CatchCode([&] { To(x); }); }
+      virtual HexceptionCode_e TryTo(bool & x) const { return CatchCode([&] { To(x); }); }
+      virtual HexceptionCode_e TryTo(char & x) const { return CatchCode([&] { To(x); }); }
+      virtual HexceptionCode_e TryTo(signed char & x) const { return CatchCode([&] { To(x); }); }
+      virtual HexceptionCode_e TryTo(signed short & x) const { return CatchCode([&] { To(x); }); }
+      virtual HexceptionCode_e TryTo(signed int & x) const { return CatchCode([&] { To(x); }); }
+      virtual HexceptionCode_e TryTo(signed long & x) const { return CatchCode([&] { To(x); }); }
+      virtual HexceptionCode_e TryTo(signed long long & x) const { return CatchCode([&] { To(x); }); }
+      virtual HexceptionCode_e TryTo(unsigned char & x) const { return CatchCode([&] { To(x); }); }
+      virtual HexceptionCode_e TryTo(unsigned short & x) const { return CatchCode([&] { To(x); }); }
+      virtual HexceptionCode_e TryTo(unsigned int & x) const { return CatchCode([&] { To(x); }); }
+      virtual HexceptionCode_e TryTo(unsigned long & x) const { return CatchCode([&] { To(x); }); }
+      virtual HexceptionCode_e TryTo(unsigned long long & x) const { return CatchCode([&] { To(x); }); }
+      virtual HexceptionCode_e TryTo(float & x) const { return CatchCode([&] { To(x); }); }
+      virtual HexceptionCode_e TryTo(double & x) const { return CatchCode([&] { To(x); }); }
+      virtual HexceptionCode_e TryTo(long double & x) const { return CatchCode([&] { To(x); }); }
+      virtual HexceptionCode_e TryTo(std::string & x) const { return CatchCode([&] { To(x); }); }
+
       virtual std::string StringData() const = 0;
 
       virtual IPrim * Clone() const = 0;
@@ -94,10 +144,14 @@ namespace hoops {
       virtual IPrim * NewIPrim(const signed short & p) const = 0;
       virtual IPrim * NewIPrim(const signed int & p) const = 0;
       virtual IPrim * NewIPrim(const signed long & p) const = 0;
+      // By default, a primitive made from the value as a long. Values which
+      // long cannot hold throw P_OVERFLOW or P_UNDERFLOW.
+      virtual IPrim * NewIPrim(const signed long long & p) const;
       virtual IPrim * NewIPrim(const unsigned char & p) const = 0;
       virtual IPrim * NewIPrim(const unsigned short & p) const = 0;
       virtual IPrim * NewIPrim(const unsigned int & p) const = 0;
       virtual IPrim * NewIPrim(const unsigned long & p) const = 0;
+      virtual IPrim * NewIPrim(const unsigned long long & p) const;
       virtual IPrim * NewIPrim(const float & p) const = 0;
       virtual IPrim * NewIPrim(const double & p) const = 0;
       virtual IPrim * NewIPrim(const long double & p) const = 0;
@@ -114,16 +168,145 @@ namespace hoops {
       virtual IPrim * NewIPrim(const signed short & p) const;
       virtual IPrim * NewIPrim(const signed int & p) const;
       virtual IPrim * NewIPrim(const signed long & p) const;
+      virtual IPrim * NewIPrim(const signed long long & p) const;
       virtual IPrim * NewIPrim(const unsigned char & p) const;
       virtual IPrim * NewIPrim(const unsigned short & p) const;
       virtual IPrim * NewIPrim(const unsigned int & p) const;
       virtual IPrim * NewIPrim(const unsigned long & p) const;
+      virtual IPrim * NewIPrim(const unsigned long long & p) const;
       virtual IPrim * NewIPrim(const float & p) const;
       virtual IPrim * NewIPrim(const double & p) const;
       virtual IPrim * NewIPrim(const long double & p) const;
       virtual IPrim * NewIPrim(const std::string & p) const;
   };
 
+  // Primitive which holds a bool, Long_t, double or std::string in place,
+  // for objects such as Par which keep their value inline rather than
+  // allocating a Prim from the factory. Conversions behave exactly as for the
+  // factory's Prim of the same type.
+  class EXPSYM PrimUnion : public IPrim {
+    public:
+      // Order matches the alternatives of Data_t.
+      enum Type_e { eBool, eLong, eDouble, eString };
+      // Integer type held for eLong: long, unless long has fewer than 64
+      // bits, in which case long long.
+      typedef std::conditional<(sizeof(long) < sizeof(long long)), long long, long>::type Long_t;
+      typedef std::variant<bool, Long_t, double, std::string> Data_t;
+
+      PrimUnion();
+      PrimUnion(Type_e type);
+      PrimUnion(const PrimUnion & p);
+      PrimUnion(PrimUnion && p) noexcept;
+      virtual ~PrimUnion();
+
+      PrimUnion & operator =(const PrimUnion & p);
+      PrimUnion & operator =(PrimUnion && p) noexcept;
+
+      Type_e Type() const { return Type_e(mData.index()); }
+
+      // Return the value if it is held as exactly type T, or else 0. This is
+      // inline, so reading or writing the held type needs no virtual call.
+      template <typename T>
+      const T * GetIf() const {
+        if constexpr (IsAlternative<T>()) return std::get_if<T>(&mData);
+        else return 0;
+      }
+      template <typename T>
+      T * GetIf() {
+        if constexpr (IsAlternative<T>()) return std::get_if<T>(&mData);
+        else return 0;
+      }
+
+      // Hold a default-constructed value of the given type.
+      void SetType(Type_e type);
+
+      virtual void From(const IPrim & x);
+      virtual void From(const bool & x);
+      virtual void From(const char & x);
+      virtual void From(const signed char & x);
+      virtual void From(const signed short & x);
+      virtual void From(const signed int & x);
+      virtual void From(const signed long & x);
+      virtual void From(const signed long long & x);
+      virtual void From(const unsigned char & x);
+      virtual void From(const unsigned short & x);
+      virtual void From(const unsigned int & x);
+      virtual void From(const unsigned long & x);
+      virtual void From(const unsigned long long & x);
+      virtual void From(const float & x);
+      virtual void From(const double & x);
+      virtual void From(const long double & x);
+      virtual void From(const std::string & x);
+      // Take over x's buffer if the value is held as a string.
+      void From(std::string && x);
+
+      virtual void To(IPrim & x) const;
+      virtual void To(bool & x) const;
+      virtual void To(char & x) const;
+      virtual void To(signed char & x) const;
+      virtual void To(signed short & x) const;
+      virtual void To(signed int & x) const;
+      virtual void To(signed long & x) const;
+      virtual void To(signed long long & x) const;
+      virtual void To(unsigned char & x) const;
+      virtual void To(unsigned short & x) const;
+      virtual void To(unsigned int & x) const;
+      virtual void To(unsigned long & x) const;
+      virtual void To(unsigned long long & x) const;
+      virtual void To(float & x) const;
+      virtual void To(double & x) const;
+      virtual void To(long double & x) const;
+      virtual void To(std::string & x) const;
+
+      virtual HexceptionCode_e TryFrom(const IPrim & x);
+      virtual HexceptionCode_e TryFrom(const bool & x);
+      virtual HexceptionCode_e TryFrom(const char & x);
+      virtual HexceptionCode_e TryFrom(const signed char & x);
+      virtual HexceptionCode_e TryFrom(const signed short & x);
+      virtual HexceptionCode_e TryFrom(const signed int & x);
+      virtual HexceptionCode_e TryFrom(const signed long & x);
+      virtual HexceptionCode_e TryFrom(const signed long long & x);
+      virtual HexceptionCode_e TryFrom(const unsigned char & x);
+      virtual HexceptionCode_e TryFrom(const unsigned short & x);
+      virtual HexceptionCode_e TryFrom(const unsigned int & x);
+      virtual HexceptionCode_e TryFrom(const unsigned long & x);
+      virtual HexceptionCode_e TryFrom(const unsigned long long & x);
+      virtual HexceptionCode_e TryFrom(const float & x);
+      virtual HexceptionCode_e TryFrom(const double & x);
+      virtual HexceptionCode_e TryFrom(const long double & x);
+      virtual HexceptionCode_e TryFrom(const std::string & x);
+
+      virtual HexceptionCode_e TryTo(IPrim & x) const;
+      virtual HexceptionCode_e TryTo(bool & x) const;
+      virtual HexceptionCode_e TryTo(char & x) const;
+      virtual HexceptionCode_e TryTo(signed char & x) const;
+      virtual HexceptionCode_e TryTo(signed short & x) const;
+      virtual HexceptionCode_e TryTo(signed int & x) const;
+      virtual HexceptionCode_e TryTo(signed long & x) const;
+      virtual HexceptionCode_e TryTo(signed long long & x) const;
+      virtual HexceptionCode_e TryTo(unsigned char & x) const;
+      virtual HexceptionCode_e TryTo(unsigned short & x) const;
+      virtual HexceptionCode_e TryTo(unsigned int & x) const;
+      virtual HexceptionCode_e TryTo(unsigned long & x) const;
+      virtual HexceptionCode_e TryTo(unsigned long long & x) const;
+      virtual HexceptionCode_e TryTo(float & x) const;
+      virtual HexceptionCode_e TryTo(double & x) const;
+      virtual HexceptionCode_e TryTo(long double & x) const;
+      virtual HexceptionCode_e TryTo(std::string & x) const;
+
+      virtual std::string StringData() const;
+
+      virtual IPrim * Clone() const;
+
+    private:
+      template <typename T>
+      static constexpr bool IsAlternative() {
+        return std::is_same<T, bool>::value || std::is_same<T, Long_t>::value ||
+          std::is_same<T, double>::value || std::is_same<T, std::string>::value;
+      }
+
+      Data_t mData;
+  };
   //////////////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////////////
@@ -48,10 +48,13 @@ namespace hoops {
       // If the comp_name argument is supplied, argv[0] is ignored.
       ParPromptGroup(int argc, char * argv[], const std::string & comp_name = std::string());
       ParPromptGroup(const ParPromptGroup & group);
+      // The moved-from group may only be destroyed or assigned by move.
+      ParPromptGroup(ParPromptGroup && group) noexcept;
 
       virtual ~ParPromptGroup();
 
       virtual IParGroup & operator =(const ParPromptGroup & g);
+      ParPromptGroup & operator =(ParPromptGroup && g) noexcept;
       virtual IParGroup & operator =(const IParGroup & g);
 
       virtual IPar & operator [](const std::string & pname) const;
@@ -61,6 +64,7 @@ namespace hoops {
       virtual IParGroup & Add(IPar * p);
       virtual IParGroup & Remove(IPar * p);
       virtual IParGroup & Remove(const std::string & pname);
+      virtual unsigned long Generation() const;
 
       virtual GenParItor begin();
       virtual ConstGenParItor begin() const;
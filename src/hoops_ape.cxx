@@ -18,6 +18,7 @@
 #include "hoops/hoops_par.h"
 #include "hoops/hoops_ape.h"
 #include "hoops/hoops_ape_factory.h"
+#include "hoops/hoops_par_file.h"
 #include "hoops/hoops_prim.h"
 
 #include "ape/ape_error.h"
@@ -30,6 +31,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -44,6 +46,7 @@ namespace hoops {
   // Static function declarations.
   //////////////////////////////////////////////////////////////////////////////
   static char *CpyStr(const char *s);
+  static bool IsModified(const IParGroup & group);
   //////////////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////////////
@@ -53,16 +56,23 @@ namespace hoops {
   //////////////////////////////////////////////////////////////////////////////
   // Begin ApeException implementation.
   //////////////////////////////////////////////////////////////////////////////
+  ApeException::ApeException(const int & code, const std::string & msg,
+    const char * filename, int line):
+    Hexception(ape2Hoops(code), msg, filename, line), mApeCode(code) {}
+
   ApeException::ApeException(const int & code, const std::string & msg,
     const std::string & filename, int line):
-    Hexception(ape2Hoops(code), filename, line), mApeCode(code) {
-      std::ostringstream os;
-      os << msg << "; Ape exception code " << code;
-      format(os.str());
-    }
+    Hexception(ape2Hoops(code), msg, filename, line), mApeCode(code) {}
 
   int ApeException::ApeCode() const { return mApeCode; }
 
+  void ApeException::format(std::string & text) const {
+    formatMsg(text);
+    text += "; Ape exception code ";
+    text += std::to_string(mApeCode);
+    formatLocation(text);
+  }
+
   int ApeException::ape2Hoops(int status) {
     // Convert ape error codes into hoops error codes in the cases where
     // there is a correspondence.
@@ -135,24 +145,77 @@ namespace hoops {
   // End ApeException implementation.
   //////////////////////////////////////////////////////////////////////////////
 
+  //////////////////////////////////////////////////////////////////////////////
+  // Begin HoopsApeSession implementation.
+  //////////////////////////////////////////////////////////////////////////////
+  HoopsApeSession::HoopsApeSession(const std::string & comp, int argc, char ** argv):
+    mComponent(comp), mArg(), mArgv() {
+    for (int ii = 0; ii < argc; ++ii) mArg.push_back(argv[ii]);
+  }
+
+  HoopsApeSession::~HoopsApeSession() { Close(); }
+
+  void HoopsApeSession::Open() {
+    if (IsOpen()) return;
+    if (0 != sCurrent) sCurrent->Close();
+
+    // Ape may keep the argument pointers, so they must outlive the session.
+    mArgv.clear();
+    for (std::vector<std::string>::iterator it = mArg.begin(); it != mArg.end(); ++it) mArgv.push_back(&(*it)[0]);
+    mArgv.push_back(0);
+
+    int status = ape_trad_init(int(mArg.size()), &mArgv[0]);
+    if (eOK != status) {
+      std::ostringstream s;
+      s << "Cannot open parameter file for " << mComponent;
+      throw ApeException(status, s.str(), __FILE__, __LINE__);
+    }
+    sCurrent = this;
+  }
+
+  void HoopsApeSession::Commit() {
+    if (!IsOpen()) return;
+    sCurrent = 0;
+    ape_trad_close(1);
+  }
+
+  void HoopsApeSession::Close() {
+    if (!IsOpen()) return;
+    sCurrent = 0;
+    ape_trad_close(0);
+  }
+  //////////////////////////////////////////////////////////////////////////////
+  // End HoopsApeSession implementation.
+  //////////////////////////////////////////////////////////////////////////////
+
   //////////////////////////////////////////////////////////////////////////////
   // Begin HoopsApeFile implementation.
   //////////////////////////////////////////////////////////////////////////////
   HoopsApeFile::HoopsApeFile(const HoopsApeFile & pf): IParFile(),
-    mComponent(pf.mComponent), mGroup(0), mArgc(0), mArgv(0) {
+    mComponent(pf.mComponent), mGroup(0), mArgc(0), mArgv(0), mSession(), mSynced(false) {
     if (pf.mGroup) mGroup = pf.mGroup->Clone();
     SetArgs(pf.mArgc, pf.mArgv);
+    mSession = pf.mSession;
+    mSynced = pf.mSynced;
+  }
+
+  HoopsApeFile::HoopsApeFile(HoopsApeFile && pf) noexcept: IParFile(),
+    mComponent(std::move(pf.mComponent)), mGroup(pf.mGroup), mArgc(pf.mArgc), mArgv(pf.mArgv),
+    mSession(std::move(pf.mSession)), mSynced(pf.mSynced) {
+    pf.mGroup = 0;
+    pf.mArgc = 0;
+    pf.mArgv = 0;
   }
 
   HoopsApeFile::HoopsApeFile(const IParFile & pf): IParFile(),
-    mComponent(pf.Component()), mGroup(0), mArgc(0), mArgv(0) {
+    mComponent(pf.Component()), mGroup(0), mArgc(0), mArgv(0), mSession(), mSynced(false) {
     mGroup = pf.Group().Clone();
     SetArgs(0, 0);
     Load();
   }
 
   HoopsApeFile::HoopsApeFile(const std::string & comp, int argc, char ** argv):
-    IParFile(), mComponent(), mGroup(0), mArgc(0), mArgv(0) {
+    IParFile(), mComponent(), mGroup(0), mArgc(0), mArgv(0), mSession(), mSynced(false) {
     if (comp.empty()) {
       SetComponent(argv[0]);
       SetArgs(argc, argv);
@@ -182,6 +245,19 @@ namespace hoops {
       if (pf.mGroup) mGroup = pf.mGroup->Clone();
     }
     SetArgs(pf.mArgc, pf.mArgv);
+    mSession = pf.mSession;
+    mSynced = pf.mSynced;
+    return *this;
+  }
+
+  HoopsApeFile & HoopsApeFile::operator =(HoopsApeFile && pf) noexcept {
+    // pf takes this file's group and arguments, and releases them in turn.
+    mComponent.swap(pf.mComponent);
+    std::swap(mGroup, pf.mGroup);
+    std::swap(mArgc, pf.mArgc);
+    std::swap(mArgv, pf.mArgv);
+    mSession.swap(pf.mSession);
+    std::swap(mSynced, pf.mSynced);
     return *this;
   }
 
@@ -193,11 +269,33 @@ namespace hoops {
       mGroup = pf.Group().Clone();
     }
     SetArgs(0, 0);
+    // The group's parameters are unmodified, but ape does not hold their values.
+    mSynced = false;
     return *this;
   }
 
   // Synchronize memory image with parameter file and vice versa.
   void HoopsApeFile::Load() {
+    // Without command line arguments the parameters come from the files alone,
+    // so they can be taken from the binary cache if it is up to date with
+    // every file ape may read: ape may prefer the system file to the user's.
+    // An open session is used as is, since ape already holds the parameters.
+    std::vector<std::string> par_files;
+    bool learn = 1 < mArgc;
+    if (!learn && !(mSession && mSession->IsOpen())) {
+      par_files = LocateParFiles(mComponent);
+      if (!par_files.empty()) {
+        if (!mGroup) mGroup = new ParGroup(mComponent);
+        if (ReadParCache(par_files, *mGroup)) { mSynced = true; return; }
+      }
+    }
+
+    // Ape learns command line values when the file is opened. Write them to
+    // the file before returning, so that tools which never call Save still
+    // remember them. Start from a fresh opening of the file, so that nothing
+    // else held by an open session, e.g. answers to prompts, is written.
+    if (learn) CloseParFile(-1);
+
     try {
       int status = eOK;
 
@@ -223,6 +321,7 @@ namespace hoops {
       // At this point, no further problems _should_ happen, so go
       // ahead and clear the current parameter group.
       if (mGroup) mGroup->Clear(); else mGroup = new ParGroup(mComponent);
+      mSynced = false;
 
       // Iterate through container.
       for (ApeListIterator par_itor = ape_list_begin(par_cont);
@@ -266,10 +365,24 @@ namespace hoops {
       throw;
     }
 
-    CloseParFile();
+    // Otherwise the file is unchanged, so the session stays open for
+    // prompting and saving.
+    if (learn) CloseParFile();
+    mSynced = true;
+    if (!par_files.empty()) WriteParCache(par_files, *mGroup);
   }
 
   void HoopsApeFile::Save() const {
+    // If the group was loaded or last saved by this file, no parameter was
+    // assigned since, and no command line arguments were given, the file
+    // already holds these values. Leave it alone, so that it is not rewritten
+    // for nothing. A group from anywhere else is written in full.
+    if (mSynced && mGroup && 1 >= mArgc && !IsModified(*mGroup)) return;
+
+    // Ape may save only some of the parameters, so the cache of the file
+    // cannot be brought up to date from the group. Discard it instead.
+    RemoveParCache(LocateParFiles(mComponent));
+
     try {
       if (mGroup) {
         int status = eOK;
@@ -283,8 +396,8 @@ namespace hoops {
         std::ostringstream err_stream;
         for (it = constGroup->begin(); it != constGroup->end(); ++it) {
           par = *it;
-          if (par->Name().empty()) continue;
-          const std::string & type = par->Type();
+          // Ape already holds the values of unmodified parameters of a group it loaded.
+          if (par->Name().empty() || (mSynced && !par->IsModified())) continue;
 
           if (P_INFINITE == par->Status() || P_UNDEFINED == par->Status()) {
             status = ape_trad_set_string(par->Name().c_str(), par->Value().c_str());
@@ -293,48 +406,62 @@ namespace hoops {
                   " for component " << mComponent;
               throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
             }
-          } else if (std::string::npos != type.find("b")) {
-            bool p = *par;
-            status = ape_trad_set_bool(par->Name().c_str(), p);
-            if (eOK != status) {
-              err_stream << "Problem setting boolean parameter " << par->Name() <<
-                " for component " << mComponent;
-              throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
-            }
-          } else if (std::string::npos != type.find("f")) {
-            status = ape_trad_set_file_name(par->Name().c_str(), *par);
-            if (eOK != status) {
-              err_stream << "Problem setting file parameter " << par->Name() <<
-                " for component " << mComponent;
-              throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
-            }
-          } else if (std::string::npos != type.find("i")) {
-            long p = *par;
-            status = ape_trad_set_long(par->Name().c_str(), p);
-            if (eOK != status) {
-              err_stream << "Problem setting int parameter " << par->Name() <<
-                " for component " << mComponent;
-              throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
-            }
-          } else if (std::string::npos != type.find("r")) {
-            status = ape_trad_set_double(par->Name().c_str(), *par);
-            if (eOK != status) {
-              err_stream << "Problem setting real parameter " << par->Name() <<
-                " for component " << mComponent;
-              throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
+            continue;
+          }
+
+          switch (par->TypeCode()) {
+            case PT_BOOL: {
+              bool p = *par;
+              status = ape_trad_set_bool(par->Name().c_str(), p);
+              if (eOK != status) {
+                err_stream << "Problem setting boolean parameter " << par->Name() <<
+                  " for component " << mComponent;
+                throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
+              }
+              break;
             }
-          } else if (std::string::npos != type.find("s")) {
-            status = ape_trad_set_string(par->Name().c_str(), *par);
-            if (eOK != status) {
-              err_stream << "Problem setting string parameter " << par->Name() <<
-                " for component " << mComponent;
-              throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
+            case PT_FILE:
+              status = ape_trad_set_file_name(par->Name().c_str(), *par);
+              if (eOK != status) {
+                err_stream << "Problem setting file parameter " << par->Name() <<
+                  " for component " << mComponent;
+                throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
+              }
+              break;
+            case PT_INT: {
+              // ape stores integers as long. Values which do not fit (64 bit
+              // values where long has 32 bits) are saved as their text.
+              long p = 0;
+              if (P_OK == par->TryTo(p)) status = ape_trad_set_long(par->Name().c_str(), p);
+              else status = ape_trad_set_string(par->Name().c_str(), par->Value().c_str());
+              if (eOK != status) {
+                err_stream << "Problem setting int parameter " << par->Name() <<
+                  " for component " << mComponent;
+                throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
+              }
+              break;
             }
-          } else {
-            status = PAR_INVALID_TYPE;
-            err_stream << "Parameter " << par->Name() << " in component " << mComponent
-              << " has invalid type \"" << type << "\"";
-            throw Hexception(status, err_stream.str(), __FILE__, __LINE__);
+            case PT_REAL:
+              status = ape_trad_set_double(par->Name().c_str(), *par);
+              if (eOK != status) {
+                err_stream << "Problem setting real parameter " << par->Name() <<
+                  " for component " << mComponent;
+                throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
+              }
+              break;
+            case PT_STRING:
+              status = ape_trad_set_string(par->Name().c_str(), *par);
+              if (eOK != status) {
+                err_stream << "Problem setting string parameter " << par->Name() <<
+                  " for component " << mComponent;
+                throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
+              }
+              break;
+            default:
+              status = PAR_INVALID_TYPE;
+              err_stream << "Parameter " << par->Name() << " in component " << mComponent
+                << " has invalid type \"" << par->Type() << "\"";
+              throw Hexception(status, err_stream.str(), __FILE__, __LINE__);
           }
         }
       } else {
@@ -345,6 +472,9 @@ namespace hoops {
       throw;
     }
     CloseParFile();
+
+    for (GenParItor it = mGroup->begin(); it != mGroup->end(); ++it) (*it)->SetModified(false);
+    mSynced = true;
   }
 
   IParGroup & HoopsApeFile::Group() {
@@ -359,11 +489,13 @@ namespace hoops {
 
   HoopsApeFile & HoopsApeFile::SetComponent(const std::string & comp) {
     CleanComponent(comp, mComponent);
+    mSession.reset();
+    mSynced = false;
     return *this;
   }
 
   IParGroup * HoopsApeFile::SetGroup(IParGroup * group)
-    { IParGroup * retval = mGroup; mGroup = group; return retval; }
+    { IParGroup * retval = mGroup; mGroup = group; mSynced = false; return retval; }
 
   GenParItor HoopsApeFile::begin() {
     if (!mGroup) {
@@ -419,26 +551,17 @@ namespace hoops {
     if (std::string::npos != pos) clean.erase(pos);
   }
 
-  // Note: in this method, argc and argv must *not* include
-  // the name of the tool (traditionally argv[0])
+  // Open the par file with the current arguments, unless this file's
+  // session already has it open.
   void HoopsApeFile::OpenParFile() const {
-    int status = eOK;
-
-    // Open the par file with the new arguments.
-    // Don't throw an exception (if necessary) until after the
-    // clean up block.
-    status = ape_trad_init(mArgc, mArgv);
-
-    if (eOK != status) {
-      std::ostringstream s;
-      s << "Cannot open parameter file for " << mComponent;
-      throw ApeException(status, s.str(), __FILE__, __LINE__);
-    }
-
+    if (!mSession) mSession.reset(new HoopsApeSession(mComponent, mArgc, mArgv));
+    mSession->Open();
   }
 
+  // Commit the session if status is 0, otherwise discard its changes.
   void HoopsApeFile::CloseParFile(int status) const {
-    ape_trad_close(0 == status ? 1 : 0);
+    if (!mSession) return;
+    if (0 == status) mSession->Commit(); else mSession->Close();
   }
 
   void HoopsApeFile::SetArgs(int argc, char ** argv) {
@@ -452,6 +575,7 @@ namespace hoops {
         delete [] mArgv[ii];
       delete [] mArgv;
       mArgv = 0;
+      mArgc = 0;
     }
 
     // Copy new arguments.
@@ -463,6 +587,9 @@ namespace hoops {
           mArgv[ii] = CpyStr(argv[ii]);
       }
     }
+
+    // A session opened with the old arguments no longer applies.
+    mSession.reset();
   }
   //////////////////////////////////////////////////////////////////////////////
   // End HoopsApeFile implementation.
@@ -479,7 +606,7 @@ namespace hoops {
   HoopsApePrompt::HoopsApePrompt(const IParPrompt & prompt):
     IParPrompt(), mFile(0) {
     mFile = new HoopsApeFile("", prompt.Argc(), prompt.Argv());
-    mFile->Group() = prompt.Group();
+    delete mFile->SetGroup(prompt.Group().Clone());
   }
 
   HoopsApePrompt::HoopsApePrompt(int argc, char ** argv,
@@ -531,7 +658,6 @@ namespace hoops {
     try {
       mFile->OpenParFile();
 
-      std::string type;
       std::vector<std::string>::const_iterator it;
 
       // Loop over parameter names in the list.
@@ -542,64 +668,73 @@ namespace hoops {
         IPar & par = mFile->Group().Find(*it);
 
         // Prompt using the appropriate function.
-        type = par.Type();
-
         std::ostringstream err_stream;
         try {
-          if (std::string::npos != type.find("b")) {
-            char r = 0;
-            status = ape_trad_query_bool(it->c_str(), &r);
-            if (eOK != status) {
-              err_stream << "Exception while querying for boolean parameter " << *it <<
-                " for component " << mFile->Component();
-              throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
+          switch (par.TypeCode()) {
+            case PT_BOOL: {
+              char r = 0;
+              status = ape_trad_query_bool(it->c_str(), &r);
+              if (eOK != status) {
+                err_stream << "Exception while querying for boolean parameter " << *it <<
+                  " for component " << mFile->Component();
+                throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
+              }
+              par = 0 != r;
+              break;
             }
-            par = 0 != r;
-          } else if (std::string::npos != type.find("f")) {
-            char * r = 0;
-            status = ape_trad_query_file_name(it->c_str(), &r);
-            if (eOK != status) {
+            case PT_FILE: {
+              char * r = 0;
+              status = ape_trad_query_file_name(it->c_str(), &r);
+              if (eOK != status) {
+                free(r); r = 0;
+                err_stream << "Exception while querying for file name parameter " << *it <<
+                  " for component " << mFile->Component();
+                throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
+              }
+              par = r;
               free(r); r = 0;
-              err_stream << "Exception while querying for file name parameter " << *it <<
-                " for component " << mFile->Component();
-              throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
+              break;
             }
-            par = r;
-            free(r); r = 0;
-          } else if (std::string::npos != type.find("i")) {
-            long r = 0;
-            status = ape_trad_query_long(it->c_str(), &r);
-            if (eOK != status) {
-              err_stream << "Exception while querying for int parameter " << *it <<
-                " for component " << mFile->Component();
-              throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
+            case PT_INT: {
+              long r = 0;
+              status = ape_trad_query_long(it->c_str(), &r);
+              if (eOK != status) {
+                err_stream << "Exception while querying for int parameter " << *it <<
+                  " for component " << mFile->Component();
+                throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
+              }
+              par = r;
+              break;
             }
-            par = r;
-          } else if (std::string::npos != type.find("r")) {
-            double r = 0.;
-            status = ape_trad_query_double(it->c_str(), &r);
-            if (eOK != status) {
-              err_stream << "Exception while querying for real parameter " << *it <<
-                " for component " << mFile->Component();
-              throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
+            case PT_REAL: {
+              double r = 0.;
+              status = ape_trad_query_double(it->c_str(), &r);
+              if (eOK != status) {
+                err_stream << "Exception while querying for real parameter " << *it <<
+                  " for component " << mFile->Component();
+                throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
+              }
+              par = r;
+              break;
             }
-            par = r;
-          } else if (std::string::npos != type.find("s")) {
-            char * r = 0;
-            status = ape_trad_query_string(it->c_str(), &r);
-            if (eOK != status) {
+            case PT_STRING: {
+              char * r = 0;
+              status = ape_trad_query_string(it->c_str(), &r);
+              if (eOK != status) {
+                free(r); r = 0;
+                err_stream << "Exception while querying for string parameter " << *it <<
+                  " for component " << mFile->Component();
+                throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
+              }
+              par = r;
               free(r); r = 0;
-              err_stream << "Exception while querying for string parameter " << *it <<
-                " for component " << mFile->Component();
-              throw ApeException(status, err_stream.str(), __FILE__, __LINE__);
+              break;
             }
-            par = r;
-            free(r); r = 0;
-          } else {
-            status = PAR_INVALID_TYPE;
-            err_stream << "Unable to query for parameter of type \"" << type <<
-              "\" for component " << mFile->Component();
-            throw Hexception(status, err_stream.str(), __FILE__, __LINE__);
+            default:
+              status = PAR_INVALID_TYPE;
+              err_stream << "Unable to query for parameter of type \"" << par.Type() <<
+                "\" for component " << mFile->Component();
+              throw Hexception(status, err_stream.str(), __FILE__, __LINE__);
           }
         } catch (const ApeException & x) {
           if (P_INFINITE == x.Code() || P_UNDEFINED == x.Code()) {
@@ -619,8 +754,7 @@ namespace hoops {
       throw;
     }
 
-    // Clean up.
-    mFile->CloseParFile(-1); // Don't save parameters at this point.
+    // Leave the session open; answers reach the file only when it is saved.
 
     // This non-specific error message is just in case something didn't
     // get handled more specifically above.
@@ -676,6 +810,7 @@ namespace hoops {
   //////////////////////////////////////////////////////////////////////////////
   // Static variable definitions.
   //////////////////////////////////////////////////////////////////////////////
+  HoopsApeSession * HoopsApeSession::sCurrent = 0;
   //////////////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////////////
@@ -695,6 +830,13 @@ namespace hoops {
     }
     return r;
   }
+
+  // Utility IsModified: true if any parameter in the group was modified.
+  static bool IsModified(const IParGroup & group) {
+    for (ConstGenParItor it = group.begin(); it != group.end(); ++it)
+      if ((*it)->IsModified()) return true;
+    return false;
+  }
   //////////////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////////////
@@ -13,7 +13,6 @@
 ////////////////////////////////////////////////////////////////////////////////
 // Header files.
 ////////////////////////////////////////////////////////////////////////////////
-#include <sstream>
 #include <string>
 
 #include "hoops/hoops.h"
@@ -21,95 +20,158 @@
 ////////////////////////////////////////////////////////////////////////////////
 namespace hoops {
 
+  //////////////////////////////////////////////////////////////////////////////
+  // Static variable definitions.
+  //////////////////////////////////////////////////////////////////////////////
+  // Per-thread state of WarningSink.
+  struct WarningState {
+    bool mThrow;
+    WarningSink::Handler_t mHandler;
+    void * mData;
+    unsigned long mCount[P_SIGNEDNESS + 1];
+  };
+
+  static thread_local WarningState sWarnings = { false, 0, 0, {} };
+  //////////////////////////////////////////////////////////////////////////////
+
   //////////////////////////////////////////////////////////////////////////////
   // Member function definitions.
   //////////////////////////////////////////////////////////////////////////////
   Hexception::Hexception(const int & code, const std::string & msg,
-    const std::string & filename, int line): mMsg(), mFileName(filename),
-    mCode(code), mLine(line) { format(msg); }
+    const char * filename, int line): mMsg(msg), mText(),
+    mFileName(filename), mFileNameCopy(), mCode(code), mLine(line) {}
+
+  Hexception::Hexception(const int & code, const std::string & msg,
+    const std::string & filename, int line): mMsg(msg), mText(),
+    mFileName(0), mFileNameCopy(filename), mCode(code), mLine(line) {}
 
-  const char * Hexception::what() const throw() { return mMsg.c_str(); }
+  Hexception::Hexception(const int & code, const char * msg,
+    const char * filename, int line): mMsg(), mText(),
+    mFileName(filename), mFileNameCopy(), mCode(code), mLine(line) {
+    // The message may be in a buffer which is gone by the time what() is
+    // called, so copy it. Only the empty message needs no allocation.
+    if (0 != msg && '\0' != *msg) mMsg = msg;
+  }
 
-  Hexception::Hexception(const int & code, const std::string & filename,
-    int line): mMsg(), mFileName(filename), mCode(code), mLine(line) {}
+  const char * Hexception::what() const throw() {
+    if (mText.empty()) {
+      try {
+        format(mText);
+      } catch (...) {
+        mText.clear();
+        return "hoops: exception message could not be formatted";
+      }
+    }
+    return mText.c_str();
+  }
 
-  void Hexception::format(const std::string & msg) {
-    if (!msg.empty()) mMsg = msg;
+  void Hexception::format(std::string & text) const {
+    formatMsg(text);
+    formatLocation(text);
+  }
+
+  void Hexception::formatMsg(std::string & text) const {
+    if (!mMsg.empty()) text = mMsg;
     else {
-      mMsg = "hoops: ";
+      text = "hoops: ";
       switch (mCode) {
         case P_ILLEGAL:
-          mMsg += "attempt to convert between incompatible types";
+          text += "attempt to convert between incompatible types";
           break;
         case P_OVERFLOW:
-          mMsg += "mathematical overflow occurred on conversion";
+          text += "mathematical overflow occurred on conversion";
           break;
         case P_UNDERFLOW:
-          mMsg += "mathematical underflow occurred on conversion";
+          text += "mathematical underflow occurred on conversion";
           break;
         case P_BADSIZE:
-          mMsg += "attempt to convert to a potentially smaller type";
+          text += "attempt to convert to a potentially smaller type";
           break;
         case P_PRECISION:
-          mMsg += "attempt to convert from integral to floating type or vice versa";
+          text += "attempt to convert from integral to floating type or vice versa";
           break;
         case P_SIGNEDNESS:
-          mMsg += "attempt to convert from signed to unsigned type or vice versa";
+          text += "attempt to convert from signed to unsigned type or vice versa";
           break;
         case P_STR_OVERFLOW:
-          mMsg += "attempt to convert a string which had trailing characters";
+          text += "attempt to convert a string which had trailing characters";
           break;
         case P_STR_INVALID:
-          mMsg += "attempt to convert a string which did not contain a number";
+          text += "attempt to convert a string which did not contain a number";
           break;
         case P_STR_NULL:
-          mMsg += "attempt to convert a null string";
+          text += "attempt to convert a null string";
           break;
         case P_INFINITE:
-          mMsg += "converted a string meaning infinity";
+          text += "converted a string meaning infinity";
           break;
         case P_UNDEFINED:
-          mMsg += "converted a string meaning undefined";
+          text += "converted a string meaning undefined";
           break;
         case PAR_INVALID_TYPE:
-          mMsg += "parameter type field (f, r, b, etc.) is invalid";
+          text += "parameter type field (f, r, b, etc.) is invalid";
           break;
         case PAR_ILLEGAL_CONVERSION:
-          mMsg += "attempt to convert between defined and undefined parameter objects";
+          text += "attempt to convert between defined and undefined parameter objects";
           break;
         case PAR_NOT_FOUND:
-          mMsg += "parameter was not found in group of parameters";
+          text += "parameter was not found in group of parameters";
           break;
         case PAR_FILE_CORRUPT:
-          mMsg += "one or more parameters in the file are invalid";
+          text += "one or more parameters in the file are invalid";
           break;
         case PAR_FILE_WRITE_ERROR:
-          mMsg += "error writing parameter file";
+          text += "error writing parameter file";
           break;
         case PAR_NULL_PTR:
-          mMsg += "null pointer passed";
+          text += "null pointer passed";
           break;
         case PAR_COMP_UNDEF:
-          mMsg += "the component name (base name of the parameter file) is undefined";
+          text += "the component name (base name of the parameter file) is undefined";
           break;
         default: 
-          mMsg += "unknown error condition";
+          text += "unknown error condition";
           break;
       }
     }
+  }
 
-    if (!mFileName.empty()) {
-      mMsg += " (at ";
-      mMsg += mFileName;
+  void Hexception::formatLocation(std::string & text) const {
+    const char * filename = 0 != mFileName ? mFileName : mFileNameCopy.c_str();
+    if ('\0' != *filename) {
+      text += " (at ";
+      text += filename;
       if (0 < mLine) {
-        mMsg += ": ";
-        std::ostringstream s;
-        s << mLine;
-        mMsg += s.str();
-        mMsg += ")";
+        text += ": ";
+        text += std::to_string(mLine);
       }
+      text += ")";
     }
   }
+
+  bool WarningSink::Throws() { return sWarnings.mThrow; }
+
+  void WarningSink::SetThrow(bool throw_warnings) { sWarnings.mThrow = throw_warnings; }
+
+  void WarningSink::SetHandler(Handler_t handler, void * data) {
+    sWarnings.mHandler = handler;
+    sWarnings.mData = data;
+  }
+
+  unsigned long WarningSink::Count(int code) { return IsWarning(code) ? sWarnings.mCount[code] : 0; }
+
+  void WarningSink::ClearCounts() {
+    for (int ii = 0; ii <= P_SIGNEDNESS; ++ii) sWarnings.mCount[ii] = 0;
+  }
+
+  bool WarningSink::Take(int code) {
+    if (!IsWarning(code)) return false;
+    WarningState & state = sWarnings;
+    ++state.mCount[code];
+    if (state.mThrow) return false;
+    if (0 != state.mHandler) state.mHandler(code, state.mData);
+    return true;
+  }
   //////////////////////////////////////////////////////////////////////////////
 
 }
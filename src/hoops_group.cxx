@@ -14,7 +14,16 @@
 // Header files.
 ////////////////////////////////////////////////////////////////////////////////
 #include "hoops/hoops_group.h"
+#include "hoops/hoops_par.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <sstream>
 #include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 ////////////////////////////////////////////////////////////////////////////////
 namespace hoops {
@@ -22,76 +31,211 @@ namespace hoops {
   //////////////////////////////////////////////////////////////////////////////
   // Constants.
   //////////////////////////////////////////////////////////////////////////////
+  // Binary group format: magic, byte order and type sizes, count, then each
+  // parameter's fields followed by a tag and the value in its native type.
+  static const char sBinaryMagic[8] = { 'H', 'O', 'O', 'P', 'S', 'P', 'G', '1' };
+  static const std::uint32_t sByteOrder = 0x01020304;
+  enum BinaryValue_e { eNoValue, eBoolValue, eLongValue, eDoubleValue, eStringValue, eSpecialValue };
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Static function declarations.
+  //////////////////////////////////////////////////////////////////////////////
+  template <typename T>
+  static void WriteRaw(std::ostream & os, const T & value);
+  template <typename T>
+  static void ReadRaw(const char *& ptr, const char * end, T & value);
+  static void WriteString(std::ostream & os, const std::string & s);
+  static void ReadString(const char *& ptr, const char * end, std::string & s);
+  static unsigned long NewGeneration();
+  template <typename T>
+  static bool IsUnique(const std::shared_ptr<T> & p);
   //////////////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////////////
   // Type definitions.
   //////////////////////////////////////////////////////////////////////////////
-  ParGroup::ParGroup(const std::string & name): IParGroup(), mPars(),
-    mGroupName(name) {}
-  ParGroup::ParGroup(const ParGroup & g): IParGroup(), mPars(),
-    mGroupName(g.mGroupName) {
-    std::vector<IPar *>::const_iterator it;
-    for (it = g.mPars.begin(); it != g.mPars.end(); ++it) 
-      mPars.push_back((*it)->Clone());
+  unsigned long IParGroup::NextGeneration() { return NewGeneration(); }
+
+  ParGroup::ParGroup(const std::string & name): IParGroup(), mPars(), mIndex(),
+    mForeign(false), mGroupName(name), mGeneration(NextGeneration()), mFrozen(false) {}
+  ParGroup::ParGroup(const ParGroup & g): IParGroup(), mPars(), mIndex(),
+    mForeign(false), mGroupName(g.mGroupName), mGeneration(NextGeneration()), mFrozen(false) { Copy(g); }
+  ParGroup::ParGroup(ParGroup && g) noexcept: IParGroup(), mPars(std::move(g.mPars)),
+    mIndex(std::move(g.mIndex)), mForeign(g.mForeign),
+    mGroupName(std::move(g.mGroupName)), mGeneration(NextGeneration()), mFrozen(false) {
+    for (Container_t::iterator it = mPars.begin(); it != mPars.end(); ++it) Own(*it);
+    g.mPars.clear();
+    g.mIndex.reset();
+    g.mGeneration = NextGeneration();
   }
 
   ParGroup::~ParGroup() { Clear(); }
 
   ParGroup & ParGroup::operator =(const IParGroup & g) {
+    const ParGroup * par_group = dynamic_cast<const ParGroup *>(&g);
+    if (0 != par_group) return ParGroup::operator =(*par_group);
     ConstGenParItor it;
     Clear();
     for (it = g.begin(); it != g.end(); ++it) 
-      mPars.push_back((*it)->Clone());
+      Add((*it)->Clone());
     return *this;
   }
 
   ParGroup & ParGroup::operator =(const ParGroup & g) {
-    std::vector<IPar *>::const_iterator it;
-    Clear();
-    for (it = g.mPars.begin(); it != g.mPars.end(); ++it) 
-      mPars.push_back((*it)->Clone());
+    if (this != &g) { Clear(); Copy(g); }
     return *this;
   }
 
-  IPar & ParGroup::Find(const std::string & pname) const {
-    std::vector<IPar *>::const_iterator it;
-
-    // Look for a parameter with the given name.
-    for (it = mPars.begin(); it != mPars.end(); ++it)
-      if (!pname.compare((*it)->Name())) break;
-
-    // If not found, throw an exception to indicate this fact.
-    if (it == mPars.end()) throw Hexception(PAR_NOT_FOUND,
-      "Parameter " + pname + " not found in parameter group " + mGroupName,
-      __FILE__, __LINE__);
-
-    // Otherwise, return the found parameter.
-    return *(*it);
+  ParGroup & ParGroup::operator =(ParGroup && g) noexcept {
+    if (this != &g) {
+      Clear();
+      mPars.swap(g.mPars);
+      for (Container_t::iterator it = mPars.begin(); it != mPars.end(); ++it) Own(*it);
+      mIndex = std::move(g.mIndex);
+      mForeign = g.mForeign;
+      g.mIndex.reset();
+      g.mGeneration = NextGeneration();
+    }
+    return *this;
   }
 
+  IPar & ParGroup::Find(const std::string & pname) const { return *mPars[Position(pname)]; }
+
   ParGroup & ParGroup::Clear() {
     std::vector<IPar *>::iterator it;
     for (it = mPars.begin(); it != mPars.end(); ++it) delete *it;
     mPars.clear();
+    mIndex.reset();
+    mGeneration = NextGeneration();
     return *this;
   }
 
-  ParGroup & ParGroup::Add(IPar * p)
-    { if (p) mPars.push_back(p); return *this; }
+  ParGroup & ParGroup::Add(IPar * p) {
+    if (p) {
+      mPars.push_back(p);
+      Own(p);
+      if (!mIndex) {
+        Reindex();
+      } else {
+        if (!IsUnique(mIndex)) mIndex.reset(new Index_t(*mIndex));
+        // If the name is already present, the first parameter keeps it.
+        mIndex->insert(Index_t::value_type(p->Name(), mPars.size() - 1));
+        if (typeid(*p) != typeid(Par)) mForeign = true;
+      }
+      mGeneration = NextGeneration();
+    }
+    return *this;
+  }
   
   ParGroup & ParGroup::Remove(IPar * p) { Remove(p->Name()); return *this; }
 
   ParGroup & ParGroup::Remove(const std::string & pname) {
-    std::vector<IPar *>::iterator it;
-    for (it = mPars.begin(); it != mPars.end(); ++it) {
+    bool removed = false;
+    std::vector<IPar *>::iterator it = mPars.begin();
+    while (it != mPars.end()) {
       if (!pname.compare((*it)->Name())) {
         delete (*it);
-        mPars.erase(it);
+        it = mPars.erase(it);
+        removed = true;
+      } else {
+        ++it;
       }
     }
+    // Rebuild rather than erase one key: positions after the removed
+    // parameters have changed.
+    if (removed) { Reindex(); mGeneration = NextGeneration(); }
     return *this;
   }
+
+  void ParGroup::Copy(const ParGroup & g) {
+    // Cloning a Par shares its body, so this copies no strings. The
+    // positions of the parameters are the same, so the index is shared too.
+    mPars.reserve(g.mPars.size());
+    for (std::vector<IPar *>::const_iterator it = g.mPars.begin(); it != g.mPars.end(); ++it)
+      { mPars.push_back((*it)->Clone()); Own(mPars.back()); }
+    mIndex = g.mIndex;
+    mForeign = g.mForeign;
+    mGeneration = NextGeneration();
+  }
+
+  ParGroup::Container_t::size_type ParGroup::Position(const std::string & pname) const {
+    // Look for a parameter with the given name in the index. A parameter
+    // may have been renamed since it was indexed, so confirm the name.
+    if (mIndex) {
+      Index_t::const_iterator found = mIndex->find(pname);
+      if (found != mIndex->end() && !pname.compare(mPars[found->second]->Name())) {
+        // The index holds the first parameter with each name, but an earlier
+        // parameter which is not a Par may since have been renamed to pname.
+        // Snapshots are never renamed.
+        if (mFrozen || !mForeign) return found->second;
+        Container_t::size_type pos = 0;
+        for (; pos != found->second; ++pos)
+          if (!pname.compare(mPars[pos]->Name())) break;
+        return pos;
+      }
+    }
+
+    // Index is stale or parameter is absent, so fall back on a linear search.
+    Container_t::size_type pos = 0;
+    for (; pos != mPars.size(); ++pos)
+      if (!pname.compare(mPars[pos]->Name())) break;
+
+    // If not found, throw an exception to indicate this fact.
+    if (pos == mPars.size()) throw Hexception(PAR_NOT_FOUND,
+      "Parameter " + pname + " not found in parameter group " + mGroupName,
+      __FILE__, __LINE__);
+
+    // Otherwise, return the found position. The index is brought up to date
+    // by the next change to the group.
+    return pos;
+  }
+
+  void ParGroup::Own(IPar * p) {
+    if (typeid(*p) == typeid(Par)) static_cast<Par *>(p)->mOwner = this;
+  }
+
+  void ParGroup::Reindex() {
+    if (mFrozen) return;
+    mForeign = false;
+    // Build a new index rather than change one a copy may share.
+    std::shared_ptr<Index_t> index(new Index_t());
+    for (Container_t::size_type pos = 0; pos != mPars.size(); ++pos) {
+      index->insert(Index_t::value_type(mPars[pos]->Name(), pos));
+      if (typeid(*mPars[pos]) != typeid(Par)) mForeign = true;
+    }
+    mIndex = index;
+  }
+
+  SharedParGroup::SharedParGroup(const IParGroup & group): mCurrent(), mWriteMutex() { Publish(group); }
+
+  SharedParGroup::~SharedParGroup() {}
+
+  SharedParGroup::Snapshot_t SharedParGroup::Snapshot() const { return ParSnapshot(Current()); }
+
+  void SharedParGroup::Publish(const IParGroup & group) {
+    // Keep the group's name if it has one.
+    const ParGroup * par_group = dynamic_cast<const ParGroup *>(&group);
+    std::shared_ptr<ParGroup> next(0 != par_group ? new ParGroup(*par_group) : new ParGroup("shared"));
+    if (0 == par_group) *next = group;
+    std::lock_guard<std::mutex> lock(mWriteMutex);
+    Store(next);
+  }
+
+  void SharedParGroup::Store(const std::shared_ptr<ParGroup> & group) {
+    // Index every name now, so that Find never needs to update the index
+    // while readers share the group. Parameters may have been renamed.
+    group->Reindex();
+    // Likewise render every value, so that Value() only reads its cache.
+    // Parameters shared with the previous version were rendered already.
+    const ParGroup & next = *group;
+    for (const IPar & par : next.Pars()) par.Value();
+    // Readers never change the snapshot, so it need never reindex.
+    group->mFrozen = true;
+    std::atomic_store(&mCurrent, std::shared_ptr<const ParGroup>(group));
+  }
+
+  std::shared_ptr<const ParGroup> SharedParGroup::Current() const { return std::atomic_load(&mCurrent); }
   //////////////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////////////
@@ -102,16 +246,165 @@ namespace hoops {
   //////////////////////////////////////////////////////////////////////////////
   // Static variable definitions.
   //////////////////////////////////////////////////////////////////////////////
+  // Source of group generations, shared so that no two groups use the same one.
+  static std::atomic<unsigned long> sGeneration(0);
   //////////////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////////////
   // Static function definitions.
   //////////////////////////////////////////////////////////////////////////////
+  template <typename T>
+  static void WriteRaw(std::ostream & os, const T & value)
+    { os.write(reinterpret_cast<const char *>(&value), sizeof(T)); }
+
+  template <typename T>
+  static void ReadRaw(const char *& ptr, const char * end, T & value) {
+    if (std::size_t(end - ptr) < sizeof(T))
+      throw Hexception(PAR_FILE_CORRUPT, "Binary parameter group is truncated", __FILE__, __LINE__);
+    std::memcpy(&value, ptr, sizeof(T));
+    ptr += sizeof(T);
+  }
+
+  static void WriteString(std::ostream & os, const std::string & s) {
+    WriteRaw(os, std::uint32_t(s.size()));
+    os.write(s.data(), s.size());
+  }
+
+  static void ReadString(const char *& ptr, const char * end, std::string & s) {
+    std::uint32_t size = 0;
+    ReadRaw(ptr, end, size);
+    if (std::size_t(end - ptr) < size)
+      throw Hexception(PAR_FILE_CORRUPT, "Binary parameter group is truncated", __FILE__, __LINE__);
+    s.assign(ptr, size);
+    ptr += size;
+  }
+
+  static unsigned long NewGeneration() { return ++sGeneration; }
+
+  template <typename T>
+  static bool IsUnique(const std::shared_ptr<T> & p) {
+    if (1 != p.use_count()) return false;
+    // use_count is a relaxed load. Other owners, perhaps in other threads,
+    // finished using the object before releasing it; the fence orders this
+    // thread's subsequent changes to the object after their use.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return true;
+  }
   //////////////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////////////
   // Function definitions.
   //////////////////////////////////////////////////////////////////////////////
+  void WriteBinary(std::ostream & os, const IParGroup & group) {
+    std::uint64_t num_pars = 0;
+    for (ConstGenParItor it = group.begin(); it != group.end(); ++it) ++num_pars;
+
+    os.write(sBinaryMagic, sizeof(sBinaryMagic));
+    WriteRaw(os, sByteOrder);
+    WriteRaw(os, std::uint8_t(sizeof(PrimUnion::Long_t)));
+    WriteRaw(os, std::uint8_t(sizeof(double)));
+    WriteRaw(os, num_pars);
+
+    for (ConstGenParItor it = group.begin(); it != group.end(); ++it) {
+      const IPar & par = *(*it);
+      WriteString(os, par.Name());
+      WriteString(os, par.Type());
+      WriteString(os, par.Mode());
+      WriteString(os, par.Min());
+      WriteString(os, par.Max());
+      WriteString(os, par.Prompt());
+      WriteString(os, par.Comment());
+
+      // Write the value in the type Par uses to hold it, so reading it back
+      // is an assignment rather than a parse.
+      ParTypeCode_e type = par.TypeCode();
+      bool bool_value = false;
+      PrimUnion::Long_t long_value = 0;
+      double double_value = 0.;
+      if (P_INFINITE == par.Status() || P_UNDEFINED == par.Status()) {
+        WriteRaw(os, std::uint8_t(eSpecialValue));
+        WriteString(os, par.Value());
+      } else if (0 == par.PrimValue() || PT_UNKNOWN == type) {
+        WriteRaw(os, std::uint8_t(eNoValue));
+      } else if (PT_BOOL == type && P_OK == par.TryTo(bool_value)) {
+        WriteRaw(os, std::uint8_t(eBoolValue));
+        WriteRaw(os, std::uint8_t(bool_value));
+      } else if (PT_INT == type && P_OK == par.TryTo(long_value)) {
+        WriteRaw(os, std::uint8_t(eLongValue));
+        WriteRaw(os, long_value);
+      } else if (PT_REAL == type && P_OK == par.TryTo(double_value)) {
+        WriteRaw(os, std::uint8_t(eDoubleValue));
+        WriteRaw(os, double_value);
+      } else {
+        WriteRaw(os, std::uint8_t(eStringValue));
+        WriteString(os, par.Value());
+      }
+    }
+    if (!os)
+      throw Hexception(PAR_FILE_WRITE_ERROR, "Could not write binary parameter group", __FILE__, __LINE__);
+  }
+
+  void ReadBinary(std::istream & is, IParGroup & group) {
+    std::ostringstream os;
+    os << is.rdbuf();
+    const std::string & buf = os.str();
+    ReadBinary(buf.data(), buf.data() + buf.size(), group);
+  }
+
+  void ReadBinary(const char * begin, const char * end, IParGroup & group) {
+    const char * ptr = begin;
+    std::uint32_t byte_order = 0;
+    std::uint8_t long_size = 0;
+    std::uint8_t double_size = 0;
+    std::uint64_t num_pars = 0;
+    if (std::size_t(end - ptr) < sizeof(sBinaryMagic) || 0 != std::memcmp(ptr, sBinaryMagic, sizeof(sBinaryMagic)))
+      throw Hexception(PAR_FILE_CORRUPT, "Not a binary parameter group", __FILE__, __LINE__);
+    ptr += sizeof(sBinaryMagic);
+    ReadRaw(ptr, end, byte_order);
+    ReadRaw(ptr, end, long_size);
+    ReadRaw(ptr, end, double_size);
+    if (sByteOrder != byte_order || sizeof(PrimUnion::Long_t) != long_size || sizeof(double) != double_size)
+      throw Hexception(PAR_FILE_CORRUPT, "Binary parameter group was written on a different platform",
+        __FILE__, __LINE__);
+    ReadRaw(ptr, end, num_pars);
+
+    // Read every parameter before touching group, so it is unchanged if reading fails.
+    std::vector<IPar *> pars;
+    try {
+      std::string name, type, mode, min, max, prompt, comment, value;
+      for (std::uint64_t ii = 0; ii != num_pars; ++ii) {
+        ReadString(ptr, end, name);
+        ReadString(ptr, end, type);
+        ReadString(ptr, end, mode);
+        ReadString(ptr, end, min);
+        ReadString(ptr, end, max);
+        ReadString(ptr, end, prompt);
+        ReadString(ptr, end, comment);
+        pars.push_back(new Par(name, type, mode, "", min, max, prompt, comment));
+        IPar & par = *pars.back();
+
+        std::uint8_t tag = eNoValue;
+        ReadRaw(ptr, end, tag);
+        switch (tag) {
+          case eNoValue: break;
+          case eBoolValue: { std::uint8_t v = 0; ReadRaw(ptr, end, v); par.From(0 != v); break; }
+          case eLongValue: { PrimUnion::Long_t v = 0; ReadRaw(ptr, end, v); par.From(v); break; }
+          case eDoubleValue: { double v = 0.; ReadRaw(ptr, end, v); par.From(v); break; }
+          case eStringValue: // Fall through.
+          case eSpecialValue: ReadString(ptr, end, value); par.From(value); break;
+          default:
+            throw Hexception(PAR_FILE_CORRUPT, "Binary parameter group has an unknown value tag", __FILE__, __LINE__);
+        }
+        par.SetModified(false);
+      }
+    } catch (...) {
+      for (std::vector<IPar *>::iterator it = pars.begin(); it != pars.end(); ++it) delete *it;
+      throw;
+    }
+
+    group.Clear();
+    for (std::vector<IPar *>::iterator it = pars.begin(); it != pars.end(); ++it) group.Add(*it);
+  }
   //////////////////////////////////////////////////////////////////////////////
 
 }
@@ -15,6 +15,9 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include <cstring>
 #include <iostream>
+#include <utility>
+#include "hoops/hoops_group.h"
+#include "hoops/hoops_limits.h"
 #include "hoops/hoops_par.h"
 ////////////////////////////////////////////////////////////////////////////////
 namespace hoops {
@@ -30,47 +33,67 @@ namespace hoops {
 #ifdef WIN32
   static int strcasecmp(const char *s1, const char *s2);
 #endif
+  static long ToLong(const long long & x);
+  static unsigned long ToULong(const unsigned long long & x);
   //////////////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////////////
   // Type definitions.
   //////////////////////////////////////////////////////////////////////////////
-  Par::Par(): IPar(), mName(), mType(), mMode(), mValue(0), mMin(), mMax(),
-    mPrompt(), mComment(), mValString(), mStatus(P_OK) {}
+  Par::Par(): IPar(), mBody(EmptyBody()), mModified(false), mOwner(0) {}
 
-  Par::Par(const Par & p): IPar(), mName(p.mName),
-    mType(p.mType), mMode(p.mMode), mValue(0), mMin(), mMax(),
-    mPrompt(p.mPrompt), mComment(p.mComment), mValString(p.mValString),
-    mStatus(p.mStatus) {
-    if (p.mValue) mValue = p.mValue->Clone();
+  Par::Par(const Par & p): IPar(), mBody(), mModified(p.mModified), mOwner(0) {
+    // Render the value before sharing the body, which is then never changed.
+    p.Value();
+    mBody = p.mBody;
   }
 
-  Par::Par(const IPar & p): IPar(), mName(p.Name()),
-    mType(p.Type()), mMode(p.Mode()), mValue(0), mMin(), mMax(),
-    mPrompt(p.Prompt()), mComment(p.Comment()), mValString(p.Value()),
-    mStatus(p.Status()) {
+  // Only the first call to EmptyBody allocates, so this does not throw in practice.
+  Par::Par(Par && p) noexcept: IPar(), mBody(std::move(p.mBody)), mModified(p.mModified), mOwner(0)
+    { p.mBody = EmptyBody(); }
+
+  Par::Par(const IPar & p): IPar(), mBody(new Body(p.Name(), p.Type(), p.Mode(), p.Min(), p.Max(),
+    p.Prompt(), p.Comment())), mModified(false), mOwner(0) {
+    mBody->mTypeCode = p.TypeCode();
+    mBody->mValString = p.Value();
+    mBody->mStatus = p.Status();
     if (!p.Value().empty()) From(p.Value());
+    mModified = p.IsModified();
   }
 
   Par::Par(const std::string & name, const std::string & type,
     const std::string & mode, const std::string & value,
     const std::string & min, const std::string & max,
     const std::string & prompt, const std::string & comment):
-    IPar(), mName(name), mType(type), mMode(mode),
-    mValue(0), mMin(min), mMax(max), mPrompt(prompt),
-    mComment(comment), mValString(), mStatus(P_OK) {
+    IPar(), mBody(new Body(name, type, mode, min, max, prompt, comment)), mModified(false), mOwner(0) {
     if (!value.empty()) From(value);
+    mModified = false;
   }
   //////////////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////////////
   // Destructor.
   //////////////////////////////////////////////////////////////////////////////
-  Par::~Par() {
-    delete mValue;
-  }
+  Par::~Par() {}
   //////////////////////////////////////////////////////////////////////////////
 
+  Par::Body::Body(): mName(), mType(), mTypeCode(PT_UNKNOWN), mMode(), mValue(), mHasValue(false), mMin(),
+    mMax(), mPrompt(), mComment(), mValString(), mValStringValid(true), mStatus(P_OK) {}
+
+  Par::Body::Body(const std::string & name, const std::string & type, const std::string & mode,
+    const std::string & min, const std::string & max, const std::string & prompt,
+    const std::string & comment): mName(name), mType(type), mTypeCode(ParseTypeCode(type)), mMode(mode),
+    mValue(), mHasValue(false), mMin(min), mMax(max), mPrompt(prompt), mComment(comment), mValString(),
+    mValStringValid(true), mStatus(P_OK) {}
+
+  const std::shared_ptr<Par::Body> & Par::EmptyBody() {
+    // Shared by every default constructed Par, so it is never changed.
+    static const std::shared_ptr<Body> sEmpty(new Body());
+    return sEmpty;
+  }
+
+  void Par::Unshare() { mBody.reset(new Body(*mBody)); }
+
   //////////////////////////////////////////////////////////////////////////////
   // Assignments.
   //////////////////////////////////////////////////////////////////////////////
@@ -79,9 +102,11 @@ namespace hoops {
     else if (!p.Type().empty() && !Type().empty()) {
       // Allow conversion from a "null" parameter if dest and source
       // are well defined parameter type.
-      delete mValue;
-      mValue = 0;
-      mValString.clear();
+      Body & body = Edit();
+      body.mHasValue = false;
+      body.mValString.clear();
+      body.mValStringValid = true;
+      mModified = true;
     } else {
       // At least one parameter is of undefined type. This is illegal.
       throw Hexception(PAR_ILLEGAL_CONVERSION, "", __FILE__, __LINE__);
@@ -89,148 +114,241 @@ namespace hoops {
   }
 
   void Par::From(const IPrim & p)
-    { ConvertFrom<const IPrim &>(p, mValue, mType); }
+    { ConvertFrom<const IPrim &>(p); }
 
   void Par::From(const bool & p)
-    { ConvertFrom<const bool &>(p, mValue, mType); }
+    { ConvertFrom<const bool &>(p); }
 
   void Par::From(const char & p)
-    { ConvertFrom<const char &>(p, mValue, mType); }
+    { ConvertFrom<const char &>(p); }
 
   void Par::From(const signed char & p)
-    { ConvertFrom<const signed char &>(p, mValue, mType); }
+    { ConvertFrom<const signed char &>(p); }
 
   void Par::From(const short & p)
-    { ConvertFrom<const short &>(p, mValue, mType); }
+    { ConvertFrom<const short &>(p); }
 
   void Par::From(const int & p)
-    { ConvertFrom<const int &>(p, mValue, mType); }
+    { ConvertFrom<const int &>(p); }
 
   void Par::From(const long & p)
-    { ConvertFrom<const long &>(p, mValue, mType); }
+    { ConvertFrom<const long &>(p); }
+
+  void Par::From(const long long & p)
+    { ConvertFrom<const long long &>(p); }
 
   void Par::From(const unsigned char & p)
-    { ConvertFrom<const unsigned char &>(p, mValue, mType); }
+    { ConvertFrom<const unsigned char &>(p); }
 
   void Par::From(const unsigned short & p)
-    { ConvertFrom<const unsigned short &>(p, mValue, mType); }
+    { ConvertFrom<const unsigned short &>(p); }
 
   void Par::From(const unsigned int & p)
-    { ConvertFrom<const unsigned int &>(p, mValue, mType); }
+    { ConvertFrom<const unsigned int &>(p); }
 
   void Par::From(const unsigned long & p)
-    { ConvertFrom<const unsigned long &>(p, mValue, mType); }
+    { ConvertFrom<const unsigned long &>(p); }
+
+  void Par::From(const unsigned long long & p)
+    { ConvertFrom<const unsigned long long &>(p); }
 
   void Par::From(const float & p)
-    { ConvertFrom<const float &>(p, mValue, mType); }
+    { ConvertFrom<const float &>(p); }
 
   void Par::From(const double & p)
-    { ConvertFrom<const double &>(p, mValue, mType); }
+    { ConvertFrom<const double &>(p); }
 
   void Par::From(const long double & p)
-    { ConvertFrom<const long double &>(p, mValue, mType); }
+    { ConvertFrom<const long double &>(p); }
 
   void Par::From(const char * p)
     { From(std::string(p)); }
 
-  void Par::From(const std::string & p) {
+  template <typename T>
+  void Par::FromString(T p) {
     try {
-      ConvertFrom<const std::string &>(p, mValue, mType);
-      mStatus = P_OK;
+      ConvertFrom<T>(std::forward<T>(p));
+      Edit().mStatus = P_OK;
     } catch (const Hexception & x) {
       int status = x.Code();
-      if (P_INFINITE == status || P_UNDEFINED == status) mStatus = status;
+      if (P_INFINITE == status || P_UNDEFINED == status) Edit().mStatus = status;
       else throw;
     }
   }
+
+  void Par::From(const std::string & p)
+    { FromString<const std::string &>(p); }
+
+  void Par::From(std::string && p)
+    { FromString<std::string &&>(std::move(p)); }
+  //////////////////////////////////////////////////////////////////////////////
+
+  PrimUnion::Type_e Par::PrimType() const {
+    switch (mBody->mTypeCode) {
+      case PT_BOOL: return PrimUnion::eBool;
+      case PT_INT: return PrimUnion::eLong;
+      case PT_REAL: return PrimUnion::eDouble;
+      case PT_STRING: // Fall through.
+      case PT_FILE: return PrimUnion::eString;
+      default: break;
+    }
+    throw Hexception(PAR_INVALID_TYPE,
+      std::string("Don't know how to handle parameters of type ") + mBody->mType, __FILE__, __LINE__);
+  }
   //////////////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////////////
   // Conversions.
   //////////////////////////////////////////////////////////////////////////////
   Par::operator bool () const
-    { bool r; ConvertTo<bool>(mValue, r); return r; }
+    { bool r; ConvertTo<bool>(r); return r; }
   Par::operator char () const
-    { char r; ConvertTo<char>(mValue, r); return r; }
+    { char r; ConvertTo<char>(r); return r; }
   Par::operator signed char () const
-    { signed char r; ConvertTo<signed char>(mValue, r); return r; }
+    { signed char r; ConvertTo<signed char>(r); return r; }
   Par::operator short () const
-    { short r; ConvertTo<short>(mValue, r); return r; }
+    { short r; ConvertTo<short>(r); return r; }
   Par::operator int () const
-    { int r; ConvertTo<int>(mValue, r); return r; }
+    { int r; ConvertTo<int>(r); return r; }
   Par::operator long () const
-    { long r; ConvertTo<long>(mValue, r); return r; }
+    { long r; ConvertTo<long>(r); return r; }
+
+  Par::operator long long () const
+    { long long r; ConvertTo<long long>(r); return r; }
   Par::operator unsigned char () const
-    { unsigned char r; ConvertTo<unsigned char>(mValue, r); return r; }
+    { unsigned char r; ConvertTo<unsigned char>(r); return r; }
   Par::operator unsigned short () const
-    { unsigned short r; ConvertTo<unsigned short>(mValue, r); return r; }
+    { unsigned short r; ConvertTo<unsigned short>(r); return r; }
   Par::operator unsigned int () const
-    { unsigned int r; ConvertTo<unsigned int>(mValue, r); return r; }
+    { unsigned int r; ConvertTo<unsigned int>(r); return r; }
   Par::operator unsigned long () const
-    { unsigned long r; ConvertTo<unsigned long>(mValue, r); return r; }
+    { unsigned long r; ConvertTo<unsigned long>(r); return r; }
+
+  Par::operator unsigned long long () const
+    { unsigned long long r; ConvertTo<unsigned long long>(r); return r; }
   Par::operator float () const
-    { float r; ConvertTo<float>(mValue, r); return r; }
+    { float r; ConvertTo<float>(r); return r; }
   Par::operator double () const
-    { double r; ConvertTo<double>(mValue, r); return r; }
+    { double r; ConvertTo<double>(r); return r; }
   Par::operator long double () const
-    { long double r; ConvertTo<long double>(mValue, r); return r; }
+    { long double r; ConvertTo<long double>(r); return r; }
 
   // Difference between this and Value() is that the latter handles exceptions.
-  Par::operator const char *() const {
-    ConvertTo<std::string>(mValue, mValString);
-    return mValString.c_str();
-  }
+  Par::operator const char *() const
+    { return operator const std::string &().c_str(); }
 
   Par::operator const std::string &() const {
-    ConvertTo<std::string>(mValue, mValString);
-    return mValString;
+    if (P_INFINITE == mBody->mStatus || P_UNDEFINED == mBody->mStatus) {
+      // Throw the proper exception.
+      std::string r; ConvertTo<std::string>(r);
+    }
+    return Value();
   }
 
   void Par::To(bool & p) const
-    { ConvertTo<bool>(mValue, p); }
+    { ConvertTo<bool>(p); }
 
   void Par::To(char & p) const
-    { ConvertTo<char>(mValue, p); }
+    { ConvertTo<char>(p); }
 
   void Par::To(signed char & p) const
-    { ConvertTo<signed char>(mValue, p); }
+    { ConvertTo<signed char>(p); }
 
   void Par::To(short & p) const
-    { ConvertTo<short>(mValue, p); }
+    { ConvertTo<short>(p); }
 
   void Par::To(int & p) const
-    { ConvertTo<int>(mValue, p); }
+    { ConvertTo<int>(p); }
 
   void Par::To(long & p) const
-    { ConvertTo<long>(mValue, p); }
+    { ConvertTo<long>(p); }
+
+  void Par::To(long long & p) const
+    { ConvertTo<long long>(p); }
 
   void Par::To(unsigned char & p) const
-    { ConvertTo<unsigned char>(mValue, p); }
+    { ConvertTo<unsigned char>(p); }
 
   void Par::To(unsigned short & p) const
-    { ConvertTo<unsigned short>(mValue, p); }
+    { ConvertTo<unsigned short>(p); }
 
   void Par::To(unsigned int & p) const
-    { ConvertTo<unsigned int>(mValue, p); }
+    { ConvertTo<unsigned int>(p); }
 
   void Par::To(unsigned long & p) const
-    { ConvertTo<unsigned long>(mValue, p); }
+    { ConvertTo<unsigned long>(p); }
+
+  void Par::To(unsigned long long & p) const
+    { ConvertTo<unsigned long long>(p); }
 
   void Par::To(float & p) const
-    { ConvertTo<float>(mValue, p); }
+    { ConvertTo<float>(p); }
 
   void Par::To(double & p) const
-    { ConvertTo<double>(mValue, p); }
+    { ConvertTo<double>(p); }
 
   void Par::To(long double & p) const
-    { ConvertTo<long double>(mValue, p); }
+    { ConvertTo<long double>(p); }
 
   void Par::To(std::string & p) const {
-    if (P_INFINITE == mStatus) p = mValString;
-    else if (P_UNDEFINED == mStatus) p = mValString;
+    if (P_INFINITE == mBody->mStatus) p = mBody->mValString;
+    else if (P_UNDEFINED == mBody->mStatus) p = mBody->mValString;
     // Call ConvertTo even if p was already assigned so that the proper
     // exception is thrown.
-    ConvertTo<std::string>(mValue, p);
+    ConvertTo<std::string>(p);
+  }
+
+  HexceptionCode_e Par::TryTo(bool & p) const
+    { return TryConvertTo<bool>(p); }
+
+  HexceptionCode_e Par::TryTo(char & p) const
+    { return TryConvertTo<char>(p); }
+
+  HexceptionCode_e Par::TryTo(signed char & p) const
+    { return TryConvertTo<signed char>(p); }
+
+  HexceptionCode_e Par::TryTo(short & p) const
+    { return TryConvertTo<short>(p); }
+
+  HexceptionCode_e Par::TryTo(int & p) const
+    { return TryConvertTo<int>(p); }
+
+  HexceptionCode_e Par::TryTo(long & p) const
+    { return TryConvertTo<long>(p); }
+
+  HexceptionCode_e Par::TryTo(long long & p) const
+    { return TryConvertTo<long long>(p); }
+
+  HexceptionCode_e Par::TryTo(unsigned char & p) const
+    { return TryConvertTo<unsigned char>(p); }
+
+  HexceptionCode_e Par::TryTo(unsigned short & p) const
+    { return TryConvertTo<unsigned short>(p); }
+
+  HexceptionCode_e Par::TryTo(unsigned int & p) const
+    { return TryConvertTo<unsigned int>(p); }
+
+  HexceptionCode_e Par::TryTo(unsigned long & p) const
+    { return TryConvertTo<unsigned long>(p); }
+
+  HexceptionCode_e Par::TryTo(unsigned long long & p) const
+    { return TryConvertTo<unsigned long long>(p); }
+
+  HexceptionCode_e Par::TryTo(float & p) const
+    { return TryConvertTo<float>(p); }
+
+  HexceptionCode_e Par::TryTo(double & p) const
+    { return TryConvertTo<double>(p); }
+
+  HexceptionCode_e Par::TryTo(long double & p) const
+    { return TryConvertTo<long double>(p); }
+
+  HexceptionCode_e Par::TryTo(std::string & p) const {
+    if (P_INFINITE == mBody->mStatus || P_UNDEFINED == mBody->mStatus) {
+      p = mBody->mValString;
+      return HexceptionCode_e(mBody->mStatus);
+    }
+    return TryConvertTo<std::string>(p);
   }
   //////////////////////////////////////////////////////////////////////////////
 
@@ -238,12 +356,41 @@ namespace hoops {
   // Member access.
   //////////////////////////////////////////////////////////////////////////////
   const std::string & Par::Value() const {
-    try { To(mValString); }
-    catch (const Hexception &) {}
-    return mValString;
+    // Infinite and undefined values are kept as text in mValString. A body
+    // is only shared once rendered, so this changes only unshared bodies.
+    Body & body = *mBody;
+    if (!body.mValStringValid && P_INFINITE != body.mStatus && P_UNDEFINED != body.mStatus) {
+      TryConvertTo<std::string>(body.mValString);
+      body.mValStringValid = true;
+    }
+    return body.mValString;
+  }
+
+  Par & Par::SetName(const std::string & s) {
+    Edit().mName = s;
+    // The group's index of names is out of date, so renaming a parameter
+    // changes its group too.
+    if (0 != mOwner) mOwner->Reindex();
+    return *this;
   }
   //////////////////////////////////////////////////////////////////////////////
 
+  //////////////////////////////////////////////////////////////////////////////
+  // Begin IPar implementation.
+  //////////////////////////////////////////////////////////////////////////////
+  void IPar::From(const long long & p) { From(ToLong(p)); }
+
+  void IPar::From(const unsigned long long & p) { From(ToULong(p)); }
+
+  void IPar::To(long long & p) const { long r = 0; To(r); p = r; }
+
+  void IPar::To(unsigned long long & p) const { unsigned long r = 0; To(r); p = r; }
+
+  ParTypeCode_e IPar::TypeCode() const { return ParseTypeCode(Type()); }
+  //////////////////////////////////////////////////////////////////////////////
+  // End IPar implementation.
+  //////////////////////////////////////////////////////////////////////////////
+
   //////////////////////////////////////////////////////////////////////////////
   // Global variable definitions.
   //////////////////////////////////////////////////////////////////////////////
@@ -272,6 +419,20 @@ static int strcasecmp(const char *s1, const char *s2) {
 }
 #endif
 
+  // Utility ToLong: x as a long, or throw P_OVERFLOW or P_UNDERFLOW if long
+  // cannot hold it.
+  static long ToLong(const long long & x) {
+    if (Lim<long>::max() < x) throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
+    if (Lim<long>::min() > x) throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
+    return long(x);
+  }
+
+  // Utility ToULong: x as an unsigned long, or throw P_OVERFLOW if unsigned
+  // long cannot hold it.
+  static unsigned long ToULong(const unsigned long long & x) {
+    if (Lim<unsigned long>::max() < x) throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
+    return (unsigned long)(x);
+  }
   //////////////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////////////
@@ -280,12 +441,13 @@ static int strcasecmp(const char *s1, const char *s2) {
   std::ostream & operator <<(std::ostream & os, const IPar & p) {
     if (!p.Name().empty()) {
       os << p.Name() << "," << p.Type() << "," << p.Mode() << ",";
-      if (!p.Type().compare("f") || !p.Type().compare("s")) {
+      ParTypeCode_e type = p.TypeCode();
+      if (PT_FILE == type || PT_STRING == type) {
         os << '"' << p.Value() << '"' << ",";
         if (!p.Min().empty()) os << '"' << p.Min() << '"';
         os << ",";
         if (!p.Max().empty()) os << '"' << p.Max() << '"';
-      } else if (!p.Type().compare("b")) {
+      } else if (PT_BOOL == type) {
         const char * value = p.Value().c_str();
         if (!strcasecmp(value, "true"))
           os << "\"yes\"," << p.Min() << "," << p.Max();
@@ -302,6 +464,18 @@ static int strcasecmp(const char *s1, const char *s2) {
     return os;
   }
 
+  ParTypeCode_e ParseTypeCode(const std::string & type) {
+    // Important to check for type "f" before "r", because "fr" is
+    // file readable. If we check first for "r", such a parameter
+    // is misclassified as a float (double) value.
+    if (std::string::npos != type.find('b')) return PT_BOOL;
+    else if (std::string::npos != type.find('i')) return PT_INT;
+    else if (std::string::npos != type.find('f')) return PT_FILE;
+    else if (std::string::npos != type.find('s')) return PT_STRING;
+    else if (std::string::npos != type.find('r')) return PT_REAL;
+    return PT_UNKNOWN;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
 
 }
@@ -0,0 +1,560 @@
+/******************************************************************************
+ *   File name: hoops_par_file.cxx                                            *
+ *                                                                            *
+ * Description: Implementation of native parameter file reader/writer.        *
+ *                                                                            *
+ *    Language: C++                                                           *
+ *                                                                            *
+ *      Author: hoops package maintainers (see SConscript)                    *
+ *                                                                            *
+ *  Change log: see CVS Change log at the end of the file.                    *
+ ******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+// Header files.
+////////////////////////////////////////////////////////////////////////////////
+#include "hoops/hoops.h"
+#include "hoops/hoops_group.h"
+#include "hoops/hoops_par.h"
+#include "hoops/hoops_par_file.h"
+#include "hoops/hoops_par_file_factory.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef WIN32
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+namespace hoops {
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Constants.
+  //////////////////////////////////////////////////////////////////////////////
+  // Separators between directories in PFILES. The part before ';' lists the
+  // user's directories, the part after it the system directories.
+#ifdef WIN32
+  static const char * const sPathSep = ";";
+#else
+  static const char * const sPathSep = ";:";
+#endif
+
+  // Appended to a parameter file's name to give the name of its cache.
+  static const char * const sParCacheSuffix = ".hbc";
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Static variable definitions.
+  //////////////////////////////////////////////////////////////////////////////
+  // Number of caches this process has started writing, which keeps the names
+  // of their temporary files apart.
+  static std::atomic<unsigned long> sCacheWrites(0);
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Static function declarations.
+  //////////////////////////////////////////////////////////////////////////////
+  static void CleanComponent(const std::string & comp, std::string & clean);
+  static const char * ParseField(const char * begin, const char * end, std::string_view & field, int line);
+  static bool IsBlankSpace(char c) { return ' ' == c || '\t' == c; }
+  static bool GetCacheKey(const std::vector<std::string> & par_files, std::string & key);
+  static std::string FindInPath(const std::string & path, const std::string & base_name);
+  static long GetPid();
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Type definitions.
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Begin ParFileMap implementation.
+  //////////////////////////////////////////////////////////////////////////////
+  IPar * ParLineView::NewPar() const {
+    return new Par(std::string(Name()), std::string(Type()), std::string(Mode()), std::string(Value()),
+      std::string(Min()), std::string(Max()), std::string(Prompt()), std::string(Comment()));
+  }
+
+  MappedFile::MappedFile(const std::string & file_name): mBuffer(), mData(0), mSize(0), mMapped(false) {
+#ifndef WIN32
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (0 > fd)
+      throw Hexception(PAR_NOT_FOUND, "Cannot open file " + file_name, __FILE__, __LINE__);
+    struct stat file_stat;
+    if (0 == fstat(fd, &file_stat) && 0 < file_stat.st_size) {
+      void * addr = mmap(0, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (MAP_FAILED != addr) {
+        mData = static_cast<const char *>(addr);
+        mSize = file_stat.st_size;
+        mMapped = true;
+      }
+    }
+    close(fd);
+#endif
+    // Read the file into one buffer if it could not be mapped.
+    if (!mMapped) {
+      std::ifstream is(file_name.c_str(), std::ios::in | std::ios::binary);
+      if (!is)
+        throw Hexception(PAR_NOT_FOUND, "Cannot open file " + file_name, __FILE__, __LINE__);
+      std::ostringstream os;
+      os << is.rdbuf();
+      mBuffer = os.str();
+      mData = mBuffer.data();
+      mSize = mBuffer.size();
+    }
+  }
+
+  MappedFile::~MappedFile() {
+#ifndef WIN32
+    if (mMapped) munmap(const_cast<char *>(mData), mSize);
+#endif
+  }
+
+  ParFileMap::ParFileMap(const std::string & file_name): mFileName(file_name), mFile(file_name), mLines() {
+    Parse(mFile.Data(), mFile.Data() + mFile.Size(), mLines);
+  }
+
+  ParFileMap::~ParFileMap() {}
+
+  const ParLineView * ParFileMap::Find(std::string_view pname) const {
+    if (pname.empty()) return 0;
+    for (ConstItor_t it = mLines.begin(); it != mLines.end(); ++it)
+      if (pname == it->Name()) return &*it;
+    return 0;
+  }
+
+  void ParFileMap::Load(IParGroup & group) const {
+    for (ConstItor_t it = mLines.begin(); it != mLines.end(); ++it) group.Add(it->NewPar());
+  }
+
+  void ParFileMap::Parse(const char * begin, const char * end, Container_t & lines) {
+    // Size the container once, using the number of newlines.
+    std::size_t num_lines = 1;
+    for (const char * ptr = begin; ptr != end; ++ptr) if ('\n' == *ptr) ++num_lines;
+    lines.reserve(lines.size() + num_lines);
+
+    int line = 0;
+    while (begin != end) {
+      ++line;
+      const char * eol = begin;
+      while (eol != end && '\n' != *eol) ++eol;
+      const char * next = eol == end ? end : eol + 1;
+      if (eol != begin && '\r' == *(eol - 1)) --eol;
+
+      lines.push_back(ParLineView());
+      std::string_view * field = lines.back().mField;
+
+      // Comments and blank lines keep the whole line as their comment.
+      const char * ptr = begin;
+      while (ptr != eol && IsBlankSpace(*ptr)) ++ptr;
+      if (ptr == eol || '#' == *ptr) {
+        field[ParLineView::eComment] = std::string_view(begin, eol - begin);
+        begin = next;
+        continue;
+      }
+
+      // Missing trailing fields are tolerated, as they are by Ape.
+      for (int ii = ParLineView::eName; ii != ParLineView::eComment; ++ii) {
+        if (ParLineView::eName != ii) {
+          // Skip past the comma which ended the previous field.
+          while (ptr != eol && ',' != *ptr) ++ptr;
+          if (ptr == eol) continue;
+          ++ptr;
+        }
+        ptr = ParseField(ptr, eol, field[ii], line);
+      }
+
+      // Anything following the prompt is kept verbatim as the comment.
+      field[ParLineView::eComment] = std::string_view(ptr, eol - ptr);
+      begin = next;
+    }
+  }
+  //////////////////////////////////////////////////////////////////////////////
+  // End ParFileMap implementation.
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Begin HoopsParFile implementation.
+  //////////////////////////////////////////////////////////////////////////////
+  HoopsParFile::HoopsParFile(const HoopsParFile & pf): IParFile(),
+    mComponent(pf.mComponent), mFileName(pf.mFileName), mGroup(0) {
+    if (pf.mGroup) mGroup = pf.mGroup->Clone();
+  }
+
+  HoopsParFile::HoopsParFile(HoopsParFile && pf) noexcept: IParFile(),
+    mComponent(std::move(pf.mComponent)), mFileName(std::move(pf.mFileName)), mGroup(pf.mGroup) {
+    pf.mGroup = 0;
+  }
+
+  HoopsParFile::HoopsParFile(const IParFile & pf): IParFile(),
+    mComponent(pf.Component()), mFileName(), mGroup(0) {
+    mGroup = pf.Group().Clone();
+    Load();
+  }
+
+  HoopsParFile::HoopsParFile(const std::string & comp, const std::string & file_name):
+    IParFile(), mComponent(), mFileName(file_name), mGroup(0) {
+    SetComponent(comp.empty() ? file_name : comp);
+    Load();
+  }
+
+  HoopsParFile::~HoopsParFile() { delete mGroup; }
+
+  HoopsParFile & HoopsParFile::operator =(const HoopsParFile & pf) {
+    mComponent = pf.mComponent;
+    mFileName = pf.mFileName;
+    if (mGroup) {
+      if (pf.mGroup) *mGroup = *pf.mGroup;
+      else mGroup->Clear();
+    } else {
+      if (pf.mGroup) mGroup = pf.mGroup->Clone();
+    }
+    return *this;
+  }
+
+  HoopsParFile & HoopsParFile::operator =(HoopsParFile && pf) noexcept {
+    // pf takes this file's group, and deletes it in turn.
+    mComponent.swap(pf.mComponent);
+    mFileName.swap(pf.mFileName);
+    std::swap(mGroup, pf.mGroup);
+    return *this;
+  }
+
+  HoopsParFile & HoopsParFile::operator =(const IParFile & pf) {
+    mComponent = pf.Component();
+    if (mGroup) {
+      *mGroup = pf.Group();
+    } else {
+      mGroup = pf.Group().Clone();
+    }
+    return *this;
+  }
+
+  // Synchronize memory image with parameter file and vice versa.
+  void HoopsParFile::Load() {
+    std::string file_name = FindParFile();
+    if (file_name.empty())
+      throw Hexception(PAR_NOT_FOUND, "Cannot open parameter file for " + mComponent, __FILE__, __LINE__);
+
+    ParFileMap map(file_name);
+    if (mGroup) mGroup->Clear(); else mGroup = new ParGroup(mComponent);
+    map.Load(*mGroup);
+  }
+
+  void HoopsParFile::Save() const {
+    if (!mGroup)
+      throw Hexception(PAR_NULL_PTR, "Attempt to save a NULL group of parameters", __FILE__, __LINE__);
+
+    std::ostringstream os;
+    const IParGroup * constGroup = mGroup;
+    for (ConstGenParItor it = constGroup->begin(); it != constGroup->end(); ++it) os << **it << '\n';
+
+    std::string file_name = UserParFile();
+    std::ofstream out(file_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    const std::string & text = os.str();
+    if (out) out.write(text.data(), text.size());
+    if (out) out.close();
+    if (!out)
+      throw Hexception(PAR_FILE_WRITE_ERROR, "Could not write parameter file " + file_name, __FILE__, __LINE__);
+
+    for (GenParItor it = mGroup->begin(); it != mGroup->end(); ++it) (*it)->SetModified(false);
+  }
+
+  IParGroup & HoopsParFile::Group() {
+    if (!mGroup) mGroup = new ParGroup(mComponent);
+    return *mGroup;
+  }
+
+  const IParGroup & HoopsParFile::Group() const {
+    if (!mGroup) mGroup = new ParGroup(mComponent);
+    return *mGroup;
+  }
+
+  HoopsParFile & HoopsParFile::SetComponent(const std::string & comp) {
+    CleanComponent(comp, mComponent);
+    return *this;
+  }
+
+  IParGroup * HoopsParFile::SetGroup(IParGroup * group)
+    { IParGroup * retval = mGroup; mGroup = group; return retval; }
+
+  HoopsParFile & HoopsParFile::SetFileName(const std::string & file_name) {
+    mFileName = file_name;
+    return *this;
+  }
+
+  GenParItor HoopsParFile::begin() {
+    if (!mGroup) {
+      std::ostringstream s;
+      s << "Attempt to find the beginning of a NULL group of parameters for " <<
+        mComponent;
+      throw Hexception(PAR_NULL_PTR, s.str(), __FILE__, __LINE__);
+    }
+    return mGroup->begin();
+  }
+
+  ConstGenParItor HoopsParFile::begin() const {
+    if (!mGroup) {
+      std::ostringstream s;
+      s << "Attempt to find the beginning of a NULL group of parameters for " <<
+        mComponent << " (const)";
+      throw Hexception(PAR_NULL_PTR, s.str(), __FILE__, __LINE__);
+    }
+    return static_cast<const IParGroup *>(mGroup)->begin();
+  }
+
+  GenParItor HoopsParFile::end() {
+    if (!mGroup) {
+      std::ostringstream s;
+      s << "Attempt to find the end of a NULL group of parameters for " <<
+        mComponent;
+      throw Hexception(PAR_NULL_PTR, s.str(), __FILE__, __LINE__);
+    }
+    return mGroup->end();
+  }
+
+  ConstGenParItor HoopsParFile::end() const {
+    if (!mGroup) {
+      std::ostringstream s;
+      s << "Attempt to find the end of a NULL group of parameters for " <<
+        mComponent << " (const)";
+      throw Hexception(PAR_NULL_PTR, s.str(), __FILE__, __LINE__);
+    }
+    return static_cast<const IParGroup *>(mGroup)->end();
+  }
+
+  IParFile * HoopsParFile::Clone() const { return new HoopsParFile(*this); }
+
+  void HoopsParFile::Parse(const char * begin, const char * end, IParGroup & group) {
+    ParFileMap::Container_t lines;
+    ParFileMap::Parse(begin, end, lines);
+    for (ParFileMap::ConstItor_t it = lines.begin(); it != lines.end(); ++it) group.Add(it->NewPar());
+  }
+
+  std::string HoopsParFile::FindParFile() const {
+    return mFileName.empty() ? LocateParFile(mComponent) : mFileName;
+  }
+
+  std::string HoopsParFile::UserParFile() const {
+    if (!mFileName.empty()) return mFileName;
+
+    std::string base_name = mComponent + ".par";
+    const char * pfiles = std::getenv("PFILES");
+    if (0 == pfiles) return base_name;
+
+    std::string path(pfiles);
+    std::string dir = path.substr(0, path.find_first_of(sPathSep));
+    return dir.empty() ? base_name : dir + "/" + base_name;
+  }
+  //////////////////////////////////////////////////////////////////////////////
+  // End HoopsParFile implementation.
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Begin HoopsParFileFactory implementation.
+  //////////////////////////////////////////////////////////////////////////////
+  IParFile * HoopsParFileFactory::NewIParFile(const IParFile & p)
+    { return new HoopsParFile(p); }
+
+  IParFile * HoopsParFileFactory::NewIParFile(const std::string & comp_name)
+    { return new HoopsParFile(comp_name); }
+  //////////////////////////////////////////////////////////////////////////////
+  // End HoopsParFileFactory implementation.
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Global variable definitions.
+  //////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Static function definitions.
+  //////////////////////////////////////////////////////////////////////////////
+  // Key of the cache of the given files, or false if one cannot be read.
+  // Times are in nanoseconds where the platform records them.
+  static bool GetCacheKey(const std::vector<std::string> & par_files, std::string & key) {
+    std::ostringstream os;
+    os << par_files.size() << '\n';
+    for (std::vector<std::string>::const_iterator it = par_files.begin(); it != par_files.end(); ++it) {
+      struct stat file_stat;
+      if (0 != stat(it->c_str(), &file_stat)) return false;
+      long long mtime = (long long)(file_stat.st_mtime) * 1000000000LL;
+#if defined(__linux__)
+      mtime += file_stat.st_mtim.tv_nsec;
+#elif defined(__APPLE__)
+      mtime += file_stat.st_mtimespec.tv_nsec;
+#endif
+      os << *it << '\n' << mtime << ' ' << (long long)(file_stat.st_size) << '\n';
+    }
+    key = os.str();
+    return true;
+  }
+
+  // Find base_name in the first of the directories listed in path which has it.
+  static std::string FindInPath(const std::string & path, const std::string & base_name) {
+    std::string::size_type pos = 0;
+    while (pos <= path.size()) {
+      std::string::size_type sep = path.find_first_of(sPathSep, pos);
+      if (std::string::npos == sep) sep = path.size();
+      std::string dir = path.substr(pos, sep - pos);
+      std::string file_name = dir.empty() ? base_name : dir + "/" + base_name;
+      if (std::ifstream(file_name.c_str())) return file_name;
+      pos = sep + 1;
+    }
+    return std::string();
+  }
+
+  static long GetPid() {
+#ifdef WIN32
+    return long(_getpid());
+#else
+    return long(getpid());
+#endif
+  }
+
+  static void CleanComponent(const std::string & comp, std::string & clean) {
+    clean = comp;
+    // Trim path name.
+    std::string::size_type pos = clean.rfind("/");
+    if (std::string::npos != pos) clean.erase(0, pos + 1);
+
+    // Trim extension.
+    pos = clean.rfind(".");
+    if (std::string::npos != pos) clean.erase(pos);
+  }
+
+  // Parse one field starting at begin, and return a pointer just past it.
+  // Quoted fields may contain commas and '#'.
+  static const char * ParseField(const char * begin, const char * end, std::string_view & field, int line) {
+    while (begin != end && IsBlankSpace(*begin)) ++begin;
+    if (begin != end && ('"' == *begin || '\'' == *begin)) {
+      char quote = *begin++;
+      const char * close = begin;
+      while (close != end && quote != *close) ++close;
+      if (close == end) {
+        std::ostringstream s;
+        s << "Unterminated quoted field on line " << line << " of parameter file";
+        throw Hexception(PAR_FILE_CORRUPT, s.str(), __FILE__, __LINE__);
+      }
+      field = std::string_view(begin, close - begin);
+      return close + 1;
+    }
+    const char * comma = begin;
+    while (comma != end && ',' != *comma) ++comma;
+    const char * last = comma;
+    while (last != begin && IsBlankSpace(*(last - 1))) --last;
+    field = std::string_view(begin, last - begin);
+    return comma;
+  }
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Function definitions.
+  //////////////////////////////////////////////////////////////////////////////
+  std::string LocateParFile(const std::string & comp) {
+    std::string base_name = comp + ".par";
+    const char * pfiles = std::getenv("PFILES");
+    if (0 == pfiles) return std::ifstream(base_name.c_str()) ? base_name : std::string();
+    return FindInPath(pfiles, base_name);
+  }
+
+  std::vector<std::string> LocateParFiles(const std::string & comp) {
+    std::vector<std::string> par_files;
+    const char * pfiles = std::getenv("PFILES");
+    if (0 == pfiles) return par_files;
+
+    // Without ';' every directory is both a user and a system directory.
+    std::string path(pfiles);
+#ifdef WIN32
+    std::string::size_type semi = std::string::npos;
+#else
+    std::string::size_type semi = path.find(';');
+#endif
+    std::string base_name = comp + ".par";
+    std::string user_file = FindInPath(path.substr(0, semi), base_name);
+    std::string system_file = std::string::npos == semi ? user_file : FindInPath(path.substr(semi + 1), base_name);
+    if (!user_file.empty()) par_files.push_back(user_file);
+    if (!system_file.empty() && system_file != user_file) par_files.push_back(system_file);
+    return par_files;
+  }
+
+  bool ReadParCache(const std::string & par_file, IParGroup & group)
+    { return ReadParCache(std::vector<std::string>(1, par_file), group); }
+
+  void WriteParCache(const std::string & par_file, const IParGroup & group)
+    { WriteParCache(std::vector<std::string>(1, par_file), group); }
+
+  void RemoveParCache(const std::string & par_file)
+    { RemoveParCache(std::vector<std::string>(1, par_file)); }
+
+  // The cache starts with a text key: the number of parameter files, then
+  // for each the path on one line and its modification time and size on the
+  // next. The group follows in the form written by WriteBinary.
+  bool ReadParCache(const std::vector<std::string> & par_files, IParGroup & group) {
+    std::string key;
+    if (par_files.empty() || !GetCacheKey(par_files, key)) return false;
+
+    try {
+      MappedFile cache(par_files.front() + sParCacheSuffix);
+      const char * ptr = cache.Data();
+      const char * end = ptr + cache.Size();
+
+      // Check the key, then decode the group straight from the mapping.
+      if (std::size_t(end - ptr) < key.size() || 0 != key.compare(0, key.size(), ptr, key.size())) return false;
+      ReadBinary(ptr + key.size(), end, group);
+    } catch (const Hexception &) {
+      return false;
+    }
+    return true;
+  }
+
+  void WriteParCache(const std::vector<std::string> & par_files, const IParGroup & group) {
+    std::string key;
+    if (par_files.empty() || !GetCacheKey(par_files, key)) return;
+
+    // Write a temporary file and rename it, so readers never see part of a
+    // cache. Other processes, perhaps on other hosts sharing a system pfile
+    // directory, may be writing the same cache, so the name of the temporary
+    // file is made from the process id, the time and a count of writes.
+    // The cache is only an optimization, so no failure to write it escapes.
+    std::string tmp_name;
+    try {
+      std::string cache_name = par_files.front() + sParCacheSuffix;
+      {
+        std::ostringstream os;
+        os << cache_name << ".tmp." << GetPid() << '.' << std::time(0) << '.' << ++sCacheWrites;
+        tmp_name = os.str();
+      }
+      std::ofstream os(tmp_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!os) return;
+      os << key;
+      WriteBinary(os, group);
+      os.close();
+      if (os && 0 == std::rename(tmp_name.c_str(), cache_name.c_str())) return;
+    } catch (const std::exception &) {
+    }
+    if (!tmp_name.empty()) std::remove(tmp_name.c_str());
+  }
+
+  void RemoveParCache(const std::vector<std::string> & par_files) {
+    if (!par_files.empty()) std::remove((par_files.front() + sParCacheSuffix).c_str());
+  }
+  //////////////////////////////////////////////////////////////////////////////
+}
+
+/******************************************************************************
+ ******************************************************************************/
@@ -14,13 +14,18 @@
 // Header files.
 ////////////////////////////////////////////////////////////////////////////////
 #include <cctype>
-#include <cerrno>
+#include <charconv>
+#include <climits>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
 #include "hoops/hoops_exception.h"
 #include "hoops/hoops_limits.h"
 #include "hoops/hoops_prim.h"
@@ -39,11 +44,8 @@ namespace hoops {
 #ifdef WIN32
   static int strcasecmp(const char *s1, const char *s2);
 #endif
-
-  static const char * float_format();
-  static const char * double_format();
-  static const char * long_double_format();
-
+  static long ToLong(const long long & x);
+  static unsigned long ToULong(const unsigned long long & x);
   //////////////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////////////
@@ -51,793 +53,290 @@ namespace hoops {
   //////////////////////////////////////////////////////////////////////////////
   class Conv {
     public:
-      static std::string TrimSpaceUpperCase(const std::string & s) {
-        std::string::const_iterator begin = s.begin();
-        std::string::const_iterator end = s.end();
-        // Trim leading space.
-        for (; begin != end && 0 != std::isspace(*begin); ++begin);
-        // Trim trailing space.
-        for (; begin != end && 0 != std::isspace(*(end-1)); --end);
-        // Copy non-blank portion.
-        std::string new_s(begin, end);
-        // Convert to upper case.
-        for (std::string::iterator itor = new_s.begin();
-          itor != new_s.end(); ++itor) *itor = std::toupper(*itor);
-        return new_s;
-      }
-      static bool IsInfinite(const std::string & s) {
+      static bool IsInfinite(std::string_view s) {
         if ("INF" == s || "INFINITY" == s || "NAN" == s) return true;
         return false;
       }
-      static bool IsUndefined(const std::string & s) {
+      static bool IsUndefined(std::string_view s) {
         if ("INDEF" == s || "NONE" == s || "UNDEF" == s || "UNDEFINED" == s)
           return true;
         return false;
       }
-      static void Convert(const bool & s, bool & d) { d = s; }
-      static void Convert(const bool & s, char & d) { d = s; }
-      static void Convert(const bool & s, signed char & d) { d = s; }
-      static void Convert(const bool & s, signed short & d) { d = s; }
-      static void Convert(const bool & s, signed int & d) { d = s; }
-      static void Convert(const bool & s, signed long & d) { d = s; }
-      static void Convert(const bool & s, unsigned char & d) { d = s; }
-      static void Convert(const bool & s, unsigned short & d) { d = s; }
-      static void Convert(const bool & s, unsigned int & d) { d = s; }
-      static void Convert(const bool & s, unsigned long & d) { d = s; }
-      static void Convert(const bool & s, float & d) { d = s; }
-      static void Convert(const bool & s, double & d) { d = s; }
-      static void Convert(const bool & s, long double & d) { d = s; }
-      static void Convert(const bool & s, std::string & d)
-        { if (s) d = "true"; else d = "false"; }
 
-      static void Convert(const char & s, bool & d) {
-        if (Lim<char>::is_signed && s < char(Lim<bool>::min())) {
-          d = Lim<bool>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > char(Lim<bool>::max())) {
-          d = Lim<bool>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (0 != s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const char & s, char & d) { d = s; }
-      static void Convert(const char & s, signed char & d) {
-        if (!Lim<char>::is_signed && s > (char) Lim<signed char>::max())
-          { d = Lim<signed char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed char)(s); throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const char & s, signed short & d) {
-        if (!Lim<char>::is_signed &&
-          (unsigned short) s > (unsigned short) Lim<signed short>::max())
-          { d = Lim<signed short>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed short)(s); throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const char & s, signed int & d) {
-        if (!Lim<char>::is_signed &&
-          (unsigned int) s > (unsigned int) Lim<signed int>::max())
-          { d = Lim<signed int>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed int)(s); throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const char & s, signed long & d) {
-        if (!Lim<char>::is_signed &&
-          (unsigned long) s > (unsigned long) Lim<signed long>::max())
-          { d = Lim<signed long>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed long)(s); throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const char & s, unsigned char & d) {
-        if (Lim<char>::is_signed && s < (char) Lim<unsigned char>::min())
-          { d = Lim<unsigned char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__); }
-        else { d = (unsigned char)(s); throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const char & s, unsigned short & d) {
-        if (Lim<char>::is_signed &&
-          (signed short) s < (signed short) Lim<unsigned short>::min())
-          { d = Lim<unsigned short>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__); }
-        else { d = (unsigned short)(s); throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const char & s, unsigned int & d) {
-        if (Lim<char>::is_signed &&
-          (signed int) s < (signed int) Lim<unsigned int>::min())
-          { d = Lim<unsigned int>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__); }
-        else { d = (unsigned int)(s); throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const char & s, unsigned long & d) {
-        if (Lim<char>::is_signed &&
-          (signed long) s < (signed long) Lim<unsigned long>::min())
-          { d = Lim<unsigned long>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__); }
-        else { d = (unsigned long)(s); throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
+      // Return P_INFINITE or P_UNDEFINED if s names such a value, ignoring
+      // case and surrounding space, or P_OK otherwise. Nothing is copied to
+      // the heap: the names are short, so an upper case copy fits in buf.
+      static HexceptionCode_e SpecialValue(const std::string & s) {
+        const char * begin = s.data();
+        const char * end = begin + s.size();
+        for (; begin != end && 0 != std::isspace((unsigned char)(*begin)); ++begin);
+        for (; begin != end && 0 != std::isspace((unsigned char)(*(end - 1))); --end);
+        char buf[16];
+        if (sizeof(buf) < std::size_t(end - begin)) return P_OK;
+        char * uc_end = buf;
+        for (; begin != end; ++begin) *uc_end++ = std::toupper((unsigned char)(*begin));
+        std::string_view s_uc(buf, uc_end - buf);
+        if (IsInfinite(s_uc)) return P_INFINITE;
+        else if (IsUndefined(s_uc)) return P_UNDEFINED;
+        return P_OK;
       }
-      static void Convert(const char & s, float & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const char & s, double & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const char & s, long double & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const char & s, std::string & d)
-        { char buf[16]; sprintf(buf, "%d", s); d = buf; }
 
-      static void Convert(const signed char & s, bool & d) {
-        if (s < char(Lim<bool>::min())) {
-          d = Lim<bool>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > char(Lim<bool>::max())) {
-          d = Lim<bool>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (0 != s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed char & s, char & d) {
-        if (!Lim<char>::is_signed && s < (signed char) Lim<char>::min()) {
-          d = Lim<char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else { d = char(s); throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed char & s, signed char & d) { d = s; }
-      static void Convert(const signed char & s, signed short & d) { d = s; }
-      static void Convert(const signed char & s, signed int & d) { d = s; }
-      static void Convert(const signed char & s, signed long & d) { d = s; }
-      static void Convert(const signed char & s, unsigned char & d) {
-        if (s < (signed char) Lim<unsigned char>::min())
-          { d = Lim<unsigned char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__); }
-        else { d = (unsigned char) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed char & s, unsigned short & d) {
-        if (s < (signed short) Lim<unsigned short>::min())
-          { d = Lim<unsigned short>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__); }
-        else { d = (unsigned short) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed char & s, unsigned int & d) {
-        if (s < (signed int) Lim<unsigned int>::min())
-          { d = Lim<unsigned int>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__); }
-        else { d = (unsigned int) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed char & s, unsigned long & d) {
-        if (s < (signed long) Lim<unsigned long>::min())
-          { d = Lim<unsigned long>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__); }
-        else { d = (unsigned long) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
+      // Parse the integer at the start of s as strtoul would with base 0:
+      // leading space, an optional sign, and 0x or 0 prefixes for hexadecimal
+      // and octal. Return the first character not parsed, which is the
+      // start of s if there is no number. The magnitude is parsed by
+      // std::from_chars, which neither allocates nor depends on the locale.
+      // U is unsigned long or unsigned long long.
+      template <typename U>
+      static const char * ParseInteger(const std::string & s, U & magnitude, bool & negative,
+        bool & out_of_range) {
+        const char * begin = s.c_str();
+        const char * end = begin + s.size();
+        const char * ptr = begin;
+        magnitude = 0;
+        negative = false;
+        out_of_range = false;
+        for (; ptr != end && 0 != std::isspace((unsigned char)(*ptr)); ++ptr);
+        if (ptr != end && ('+' == *ptr || '-' == *ptr)) negative = '-' == *ptr++;
+        int base = 10;
+        if (ptr != end && '0' == *ptr) {
+          if (2 < end - ptr && ('x' == ptr[1] || 'X' == ptr[1]) && 0 != std::isxdigit((unsigned char)(ptr[2]))) {
+            base = 16;
+            ptr += 2;
+          } else {
+            base = 8;
+          }
+        }
+        std::from_chars_result result = std::from_chars(ptr, end, magnitude, base);
+        if (std::errc::invalid_argument == result.ec) return begin;
+        out_of_range = std::errc::result_out_of_range == result.ec;
+        return result.ptr;
       }
-      static void Convert(const signed char & s, float & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const signed char & s, double & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const signed char & s, long double & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const signed char & s, std::string & d)
-        { char buf[16]; sprintf(buf, "%d", s); d = buf; }
 
-      static void Convert(const signed short & s, bool & d) {
-        if (s < (signed short)(Lim<bool>::min())) {
-          d = Lim<bool>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > (signed short)(Lim<bool>::max())) {
-          d = Lim<bool>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (0 != s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed short & s, char & d) {
-        if (s < (signed short) Lim<char>::min()) {
-          d = Lim<char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if ((unsigned short) s > (unsigned short) Lim<char>::max()) {
-          d = Lim<char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = char(s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed short & s, signed char & d) {
-        if (s < Lim<signed char>::min()) {
-          d = Lim<signed char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<signed char>::max()) {
-          d = Lim<signed char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (signed char)(s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed short & s, signed short & d) { d = s; }
-      static void Convert(const signed short & s, signed int & d) { d = s; }
-      static void Convert(const signed short & s, signed long & d) { d = s; }
-      static void Convert(const signed short & s, unsigned char & d) {
-        if (s < (signed short) Lim<unsigned char>::min()) {
-          d = Lim<unsigned char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if ((unsigned short) s > Lim<unsigned char>::max()) {
-          d = Lim<unsigned char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned char) s; if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed short & s, unsigned short & d) {
-        if (s < (signed short) Lim<unsigned short>::min()) {
-          d = Lim<unsigned short>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned short) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed short & s, unsigned int & d) {
-        if (s < (signed int) Lim<unsigned int>::min()) {
-          d = Lim<unsigned int>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned int) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed short & s, unsigned long & d) {
-        if (s < (signed long) Lim<unsigned long>::min()) {
-          d = Lim<unsigned long>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned long) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
+      // Equivalents of strtol/strtoll and strtoul/strtoull with base 0, which
+      // report overflow in out_of_range rather than errno. T is the signed or
+      // unsigned long or long long type parsed.
+      template <typename T>
+      static const char * ParseSigned(const std::string & s, T & val, bool & out_of_range) {
+        typedef typename std::make_unsigned<T>::type U;
+        U magnitude = 0;
+        bool negative = false;
+        const char * r = ParseInteger(s, magnitude, negative, out_of_range);
+        U limit = U(Lim<T>::max()) + (negative ? 1u : 0u);
+        if (out_of_range || limit < magnitude) {
+          out_of_range = true;
+          val = negative ? Lim<T>::min() : Lim<T>::max();
+        } else {
+          val = negative ? T(U(0) - magnitude) : T(magnitude);
+        }
+        return r;
+      }
+      template <typename T>
+      static const char * ParseUnsigned(const std::string & s, T & val, bool & out_of_range) {
+        T magnitude = 0;
+        bool negative = false;
+        const char * r = ParseInteger(s, magnitude, negative, out_of_range);
+        // Like strtoul, negate a negative number in unsigned arithmetic.
+        if (out_of_range) val = Lim<T>::max();
+        else val = negative ? T(0) - magnitude : magnitude;
+        return r;
       }
-      static void Convert(const signed short & s, float & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const signed short & s, double & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const signed short & s, long double & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const signed short & s, std::string & d)
-        { char buf[16]; sprintf(buf, "%hd", s); d = buf; }
 
-      static void Convert(const signed int & s, bool & d) {
-        if (s < (signed int)(Lim<bool>::min())) {
-          d = Lim<bool>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > (signed int)(Lim<bool>::max())) {
-          d = Lim<bool>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (0 != s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed int & s, char & d) {
-        if (s < (signed int) Lim<char>::min()) {
-          d = Lim<char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if ((unsigned int) s > (unsigned int) Lim<char>::max()) {
-          d = Lim<char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = char(s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed int & s, signed char & d) {
-        if (s < Lim<signed char>::min()) {
-          d = Lim<signed char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<signed char>::max()) {
-          d = Lim<signed char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (signed char)(s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed int & s, signed short & d) {
-        if (s < Lim<signed short>::min()) {
-          d = Lim<signed short>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<signed short>::max()) {
-          d = Lim<signed short>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (signed short)(s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed int & s, signed int & d) { d = s; }
-      static void Convert(const signed int & s, signed long & d) { d = s; }
-      static void Convert(const signed int & s, unsigned char & d) {
-        if (s < (signed int) Lim<unsigned char>::min()) {
-          d = Lim<unsigned char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if ((unsigned int) s > Lim<unsigned char>::max()) {
-          d = Lim<unsigned char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned char) s; if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed int & s, unsigned short & d) {
-        if (s < (signed int) Lim<unsigned short>::min()) {
-          d = Lim<unsigned short>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if ((unsigned int) s > Lim<unsigned short>::max()) {
-          d = Lim<unsigned short>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned short) s; if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed int & s, unsigned int & d) {
-        if (s < (signed int) Lim<unsigned int>::min()) {
-          d = Lim<unsigned int>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned int) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed int & s, unsigned long & d) {
-        if (s < (signed long) Lim<unsigned long>::min()) {
-          d = Lim<unsigned long>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned long) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
+      // Parse the floating point number at the start of s as strtod would,
+      // including hexadecimal and infinite values, but independent of the
+      // locale and correctly rounded for T. Values too large or too small
+      // for T (but not subnormal values) set out_of_range.
+      template <typename T>
+      static const char * ParseFloat(const std::string & s, T & val, bool & out_of_range) {
+        const char * begin = s.c_str();
+        const char * end = begin + s.size();
+        const char * ptr = begin;
+        val = T();
+        out_of_range = false;
+        for (; ptr != end && 0 != std::isspace((unsigned char)(*ptr)); ++ptr);
+        bool negative = false;
+        if (ptr != end && ('+' == *ptr || '-' == *ptr)) negative = '-' == *ptr++;
+        // std::from_chars accepts its own minus sign, which would be a second sign here.
+        if (ptr != end && '-' == *ptr) return begin;
+        std::chars_format format = std::chars_format::general;
+        if (2 < end - ptr && '0' == ptr[0] && ('x' == ptr[1] || 'X' == ptr[1]) &&
+          (0 != std::isxdigit((unsigned char)(ptr[2])) || '.' == ptr[2])) {
+          format = std::chars_format::hex;
+          ptr += 2;
+        }
+        std::from_chars_result result = std::from_chars(ptr, end, val, format);
+        if (std::errc::invalid_argument == result.ec) {
+          // "0x" with no hexadecimal digits is the number 0 followed by "x".
+          if (std::chars_format::hex == format) { val = T(); return ptr - 1; }
+          return begin;
+        }
+        if (std::errc::result_out_of_range == result.ec) {
+          out_of_range = true;
+          val = T();
+        }
+        if (negative) val = -val;
+        return result.ptr;
       }
-      static void Convert(const signed int & s, float & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const signed int & s, double & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const signed int & s, long double & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const signed int & s, std::string & d)
-        { char buf[32]; sprintf(buf, "%d", s); d = buf; }
 
-      static void Convert(const signed long & s, bool & d) {
-        if (s < (signed long)(Lim<bool>::min())) {
-          d = Lim<bool>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > (signed long)(Lim<bool>::max())) {
-          d = Lim<bool>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (0 != s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed long & s, char & d) {
-        if (s < (signed long) Lim<char>::min()) {
-          d = Lim<char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if ((unsigned long) s > (unsigned long) Lim<char>::max()) {
-          d = Lim<char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = char(s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed long & s, signed char & d) {
-        if (s < Lim<signed char>::min()) {
-          d = Lim<signed char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<signed char>::max()) {
-          d = Lim<signed char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (signed char)(s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed long & s, signed short & d) {
-        if (s < Lim<signed short>::min()) {
-          d = Lim<signed short>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<signed short>::max()) {
-          d = Lim<signed short>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (signed short)(s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed long & s, signed int & d) {
-        if (s < Lim<signed int>::min()) {
-          d = Lim<signed int>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<signed int>::max()) {
-          d = Lim<signed int>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (signed int)(s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed long & s, signed long & d) { d = s; }
-      static void Convert(const signed long & s, unsigned char & d) {
-        if (s < (signed long) Lim<unsigned char>::min()) {
-          d = Lim<unsigned char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if ((unsigned long) s > Lim<unsigned char>::max()) {
-          d = Lim<unsigned char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned char) s; if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed long & s, unsigned short & d) {
-        if (s < (signed long) Lim<unsigned short>::min()) {
-          d = Lim<unsigned short>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if ((unsigned long) s > Lim<unsigned short>::max()) {
-          d = Lim<unsigned short>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned short) s; if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed long & s, unsigned int & d) {
-        if (s < (signed long) Lim<unsigned int>::min()) {
-          d = Lim<unsigned int>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if ((unsigned long) s > Lim<unsigned int>::max()) {
-          d = Lim<unsigned int>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned int) s; if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const signed long & s, unsigned long & d) {
-        if (s < (signed long) Lim<unsigned long>::min()) {
-          d = Lim<unsigned long>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned long) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
+      // Format val with the fewest digits which ParseFloat reads back as
+      // exactly the same T, independent of the locale. As with the %g format
+      // used previously, fixed notation is used for exponents from -4 up to
+      // (but not including) digits10, and scientific notation otherwise.
+      template <typename T>
+      static void FormatFloat(T val, std::string & d) {
+        char buf[64];
+        std::to_chars_result result = std::to_chars(buf, buf + sizeof(buf), val, std::chars_format::scientific);
+        const char * exp = static_cast<const char *>(std::memchr(buf, 'e', result.ptr - buf));
+        if (0 != exp) {
+          int exponent = std::atoi(exp + 1);
+          if (-4 <= exponent && exponent < Lim<T>::digits10)
+            result = std::to_chars(buf, buf + sizeof(buf), val, std::chars_format::fixed);
+        }
+        d.assign(buf, result.ptr);
       }
-      static void Convert(const signed long & s, float & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const signed long & s, double & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const signed long & s, long double & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const signed long & s, std::string & d)
-        { char buf[64]; sprintf(buf, "%ld", s); d = buf; }
 
-      static void Convert(const unsigned char & s, bool & d) {
-        if (s > (unsigned char)(Lim<bool>::max())) {
-          d = Lim<bool>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (0u != s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned char & s, char & d) {
-        if (Lim<char>::is_signed && s > (unsigned char) Lim<char>::max()) {
-          d = Lim<char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = char(s); throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned char & s, signed char & d) {
-        if (s > (unsigned char) Lim<signed char>::max())
-          { d = Lim<signed char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed char) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned char & s, signed short & d) {
-        if (s > (unsigned short) Lim<signed short>::max())
-          { d = Lim<signed short>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed short) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned char & s, signed int & d) {
-        if (s > (unsigned int) Lim<signed int>::max())
-          { d = Lim<signed int>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed int) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
+      // Format integer val in decimal, independent of the locale. Plain and
+      // signed char are formatted as numbers, as %d did.
+      template <typename T>
+      static void FormatInteger(T val, std::string & d) {
+        char buf[32];
+        std::to_chars_result result = std::is_same<T, char>::value || std::is_same<T, signed char>::value ?
+          std::to_chars(buf, buf + sizeof(buf), int(val)) : std::to_chars(buf, buf + sizeof(buf), val);
+        d.assign(buf, result.ptr);
       }
-      static void Convert(const unsigned char & s, signed long & d) {
-        if (s > (unsigned long) Lim<signed long>::max())
-          { d = Lim<signed long>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed long) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned char & s, unsigned char & d) { d = s; }
-      static void Convert(const unsigned char & s, unsigned short & d)
-        { d = s; }
-      static void Convert(const unsigned char & s, unsigned int & d) { d = s; }
-      static void Convert(const unsigned char & s, unsigned long & d) { d = s; }
-      static void Convert(const unsigned char & s, float & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const unsigned char & s, double & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const unsigned char & s, long double & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const unsigned char & s, std::string & d)
-        { char buf[16]; sprintf(buf, "%u", s); d = buf; }
 
-      static void Convert(const unsigned short & s, bool & d) {
-        if (s > (unsigned short)(Lim<bool>::max())) {
-          d = Lim<bool>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (0u != s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned short & s, char & d) {
-        if (Lim<char>::is_signed && s > (unsigned short) Lim<char>::max()) {
-          d = Lim<char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = char(s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned short & s, signed char & d) {
-        if (s > (unsigned short) Lim<signed char>::max())
-          { d = Lim<signed char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed char) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned short & s, signed short & d) {
-        if (s > (unsigned short) Lim<signed short>::max())
-          { d = Lim<signed short>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed short) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned short & s, signed int & d) {
-        if (s > (unsigned int) Lim<signed int>::max())
-          { d = Lim<signed int>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed int) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
+      // Throwing form of TryConvert, used by From/To. Warnings go to the
+      // WarningSink unless it throws them.
+      template <typename S, typename D>
+      static void Convert(const S & s, D & d) {
+        HexceptionCode_e status = TryConvert(s, d);
+        if (P_OK != status && !WarningSink::Take(status)) throw Hexception(status, "", __FILE__, __LINE__);
       }
-      static void Convert(const unsigned short & s, signed long & d) {
-        if (s > (unsigned long) Lim<signed long>::max())
-          { d = Lim<signed long>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed long) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned short & s, unsigned char & d) {
-        if (s > Lim<unsigned char>::max())
-          { d = Lim<unsigned char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (unsigned char)(s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned short & s, unsigned short & d)
-        { d = s; }
-      static void Convert(const unsigned short & s, unsigned int & d) { d = s; }
-      static void Convert(const unsigned short & s, unsigned long & d)
-        { d = s; }
-      static void Convert(const unsigned short & s, float & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const unsigned short & s, double & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const unsigned short & s, long double & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const unsigned short & s, std::string & d)
-        { char buf[16]; sprintf(buf, "%hu", s); d = buf; }
 
-      static void Convert(const unsigned int & s, bool & d) {
-        if (s > (unsigned int)(Lim<bool>::max())) {
-          d = Lim<bool>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (0u != s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned int & s, char & d) {
-        if (Lim<char>::is_signed && s > (unsigned int) Lim<char>::max()) {
-          d = Lim<char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = char(s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned int & s, signed char & d) {
-        if (s > (unsigned int) Lim<signed char>::max())
-          { d = Lim<signed char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed char) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned int & s, signed short & d) {
-        if (s > (unsigned int) Lim<signed short>::max())
-          { d = Lim<signed short>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed short) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned int & s, signed int & d) {
-        if (s > (unsigned int) Lim<signed int>::max())
-          { d = Lim<signed int>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed int) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned int & s, signed long & d) {
-        if (s > (unsigned long) Lim<signed long>::max())
-          { d = Lim<signed long>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed long) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned int & s, unsigned char & d) {
-        if (s > Lim<unsigned char>::max())
-          { d = Lim<unsigned char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (unsigned char)(s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned int & s, unsigned short & d) {
-        if (s > Lim<unsigned short>::max())
-          { d = Lim<unsigned short>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (unsigned short)(s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
+      // Each TryConvert stores the converted value in d, and returns P_OK or
+      // the code describing what happened during the conversion.
+      // Conversions between the arithmetic types all come from this one
+      // template. Which checks can fail for a given S and D, and which code a
+      // successful conversion returns, are decided at compile time from Lim<S>
+      // and Lim<D>, so each instance reduces to at most two comparisons:
+      //   - bool to anything, and any type to itself, is exact.
+      //   - Integer to floating point returns P_PRECISION.
+      //   - Floating point to a smaller floating point type is checked
+      //     against -max and max of D.
+      //   - Floating point to integer is checked against min and max of D, and
+      //     returns P_PRECISION.
+      //   - Integer to integer is checked against min and max of D. Narrowing
+      //     (see IsNarrowing) returns P_BADSIZE if sThrowBadSize is set;
+      //     otherwise a change of signedness returns P_SIGNEDNESS.
+      template <typename S, typename D>
+      static typename std::enable_if<std::is_arithmetic<S>::value && std::is_arithmetic<D>::value,
+        HexceptionCode_e>::type TryConvert(const S & s, D & d) {
+        if constexpr (std::is_same<S, D>::value || std::is_same<S, bool>::value) {
+          d = s; return P_OK;
+        } else if constexpr (std::is_floating_point<D>::value) {
+          if constexpr (!std::is_floating_point<S>::value) {
+            d = s; return P_PRECISION;
+          } else {
+            if constexpr (sizeof(D) < sizeof(S)) {
+              if (s < -Lim<D>::max()) {
+                d = -Lim<D>::max(); return P_UNDERFLOW;
+              } else if (s > Lim<D>::max()) {
+                d = Lim<D>::max(); return P_OVERFLOW;
+              }
+            }
+            d = D(s); return P_OK;
+          }
+        } else if constexpr (std::is_floating_point<S>::value) {
+          if (s < Lim<D>::min()) {
+            d = Lim<D>::min(); return P_UNDERFLOW;
+          } else if (s > Lim<D>::max()) {
+            d = Lim<D>::max(); return P_OVERFLOW;
+          } else { d = D(s); return P_PRECISION; }
+        } else {
+          if (IsBelow<D>(s)) {
+            d = Lim<D>::min(); return P_UNDERFLOW;
+          } else if (IsAbove<D>(s)) {
+            d = Lim<D>::max(); return P_OVERFLOW;
+          }
+          d = D(s);
+          if constexpr (IsNarrowing<S, D>()) { if constexpr (sThrowBadSize) return P_BADSIZE; else return P_OK; }
+          else if constexpr (IsSignChange<S, D>()) return P_SIGNEDNESS;
+          else return P_OK;
+        }
       }
-      static void Convert(const unsigned int & s, unsigned int & d) { d = s; }
-      static void Convert(const unsigned int & s, unsigned long & d) { d = s; }
-      static void Convert(const unsigned int & s, float & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const unsigned int & s, double & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const unsigned int & s, long double & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const unsigned int & s, std::string & d)
-        { char buf[32]; sprintf(buf, "%u", s); d = buf; }
 
-      static void Convert(const unsigned long & s, bool & d) {
-        if (s > (unsigned long)(Lim<bool>::max())) {
-          d = Lim<bool>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (0u != s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned long & s, char & d) {
-        if (Lim<char>::is_signed && s > (unsigned long) Lim<char>::max()) {
-          d = Lim<char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = char(s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned long & s, signed char & d) {
-        if (s > (unsigned long) Lim<signed char>::max())
-          { d = Lim<signed char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed char) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned long & s, signed short & d) {
-        if (s > (unsigned long) Lim<signed short>::max())
-          { d = Lim<signed short>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed short) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned long & s, signed int & d) {
-        if (s > (unsigned long) Lim<signed int>::max())
-          { d = Lim<signed int>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed int) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned long & s, signed long & d) {
-        if (s > (unsigned long) Lim<signed long>::max())
-          { d = Lim<signed long>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (signed long) s; throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned long & s, unsigned char & d) {
-        if (s > Lim<unsigned char>::max())
-          { d = Lim<unsigned char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (unsigned char)(s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned long & s, unsigned short & d) {
-        if (s > Lim<unsigned short>::max())
-          { d = Lim<unsigned short>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (unsigned short)(s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned long & s, unsigned int & d) {
-        if (s > Lim<unsigned int>::max())
-          { d = Lim<unsigned int>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__); }
-        else { d = (unsigned int)(s); if (sThrowBadSize) throw Hexception(P_BADSIZE, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const unsigned long & s, unsigned long & d)
-        { d = s; }
-      static void Convert(const unsigned long & s, float & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const unsigned long & s, double & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const unsigned long & s, long double & d)
-        { d = s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      static void Convert(const unsigned long & s, std::string & d)
-        { char buf[64]; sprintf(buf, "%lu", s); d = buf; }
+      // Number of bits holding the magnitude of integer type T.
+      template <typename T>
+      static constexpr int MagnitudeBits()
+        { return std::is_same<T, bool>::value ? 1 : int(CHAR_BIT * sizeof(T)) - (Lim<T>::is_signed ? 1 : 0); }
 
-      static void Convert(const float & s, bool & d) {
-        if (s < float(Lim<bool>::min())) {
-          d = Lim<bool>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > float(Lim<bool>::max())) {
-          d = Lim<bool>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (0.f != s); throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const float & s, char & d) {
-        if (s < Lim<char>::min()) {
-          d = Lim<char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<char>::max()) {
-          d = Lim<char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (char) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
+      // Whether integer s is less than the minimum of integer type D.
+      template <typename D, typename S>
+      static bool IsBelow(const S & s) {
+        if constexpr (!Lim<S>::is_signed) return false;
+        else if constexpr (!Lim<D>::is_signed) return s < S(0);
+        else if constexpr (MagnitudeBits<D>() >= MagnitudeBits<S>()) return false;
+        else return s < S(Lim<D>::min());
       }
-      static void Convert(const float & s, signed char & d) {
-        if (s < Lim<signed char>::min()) {
-          d = Lim<signed char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<signed char>::max()) {
-          d = Lim<signed char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (signed char) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const float & s, signed short & d) {
-        if (s < Lim<signed short>::min()) {
-          d = Lim<signed short>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<signed short>::max()) {
-          d = Lim<signed short>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (signed short) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const float & s, signed int & d) {
-        if (s < Lim<signed int>::min()) {
-          d = Lim<signed int>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<signed int>::max()) {
-          d = Lim<signed int>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (signed int) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const float & s, signed long & d) {
-        if (s < Lim<signed long>::min()) {
-          d = Lim<signed long>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<signed long>::max()) {
-          d = Lim<signed long>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (signed long) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const float & s, unsigned char & d) {
-        if (s < Lim<unsigned char>::min()) {
-          d = Lim<unsigned char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<unsigned char>::max()) {
-          d = Lim<unsigned char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned char) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const float & s, unsigned short & d) {
-        if (s < Lim<unsigned short>::min()) {
-          d = Lim<unsigned short>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<unsigned short>::max()) {
-          d = Lim<unsigned short>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned short) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const float & s, unsigned int & d) {
-        if (s < Lim<unsigned int>::min()) {
-          d = Lim<unsigned int>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<unsigned int>::max()) {
-          d = Lim<unsigned int>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned int) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const float & s, unsigned long & d) {
-        if (s < Lim<unsigned long>::min()) {
-          d = Lim<unsigned long>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<unsigned long>::max()) {
-          d = Lim<unsigned long>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned long) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const float & s, float & d) { d = s; }
-      static void Convert(const float & s, double & d) { d = s; }
-      static void Convert(const float & s, long double & d) { d = s; }
-      static void Convert(const float & s, std::string & d)
-        { char buf[32]; sprintf(buf, sFloatFormat, s); d = buf; }
 
-      static void Convert(const double & s, bool & d) {
-        if (s < double(Lim<bool>::min())) {
-          d = Lim<bool>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > double(Lim<bool>::max())) {
-          d = Lim<bool>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (0. != s); throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const double & s, char & d) {
-        if (s < Lim<char>::min()) {
-          d = Lim<char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<char>::max()) {
-          d = Lim<char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (char) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const double & s, signed char & d) {
-        if (s < Lim<signed char>::min()) {
-          d = Lim<signed char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<signed char>::max()) {
-          d = Lim<signed char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (signed char) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
+      // Whether integer s is greater than the maximum of integer type D.
+      template <typename D, typename S>
+      static bool IsAbove(const S & s) {
+        if constexpr (MagnitudeBits<D>() >= MagnitudeBits<S>()) return false;
+        else return s > S(Lim<D>::max());
       }
-      static void Convert(const double & s, signed short & d) {
-        if (s < Lim<signed short>::min()) {
-          d = Lim<signed short>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<signed short>::max()) {
-          d = Lim<signed short>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (signed short) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const double & s, signed int & d) {
-        if (s < Lim<signed int>::min()) {
-          d = Lim<signed int>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<signed int>::max()) {
-          d = Lim<signed int>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (signed int) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const double & s, signed long & d) {
-        if (s < Lim<signed long>::min()) {
-          d = Lim<signed long>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<signed long>::max()) {
-          d = Lim<signed long>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (signed long) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const double & s, unsigned char & d) {
-        if (s < Lim<unsigned char>::min()) {
-          d = Lim<unsigned char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<unsigned char>::max()) {
-          d = Lim<unsigned char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned char) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const double & s, unsigned short & d) {
-        if (s < Lim<unsigned short>::min()) {
-          d = Lim<unsigned short>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<unsigned short>::max()) {
-          d = Lim<unsigned short>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned short) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const double & s, unsigned int & d) {
-        if (s < Lim<unsigned int>::min()) {
-          d = Lim<unsigned int>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<unsigned int>::max()) {
-          d = Lim<unsigned int>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned int) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const double & s, unsigned long & d) {
-        if (s < Lim<unsigned long>::min()) {
-          d = Lim<unsigned long>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<unsigned long>::max()) {
-          d = Lim<unsigned long>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned long) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const double & s, float & d) {
-        if (s < -Lim<float>::max()) {
-          d = -Lim<float>::max(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<float>::max()) {
-          d = Lim<float>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = float(s); }
-      }
-      static void Convert(const double & s, double & d) { d = s; }
-      static void Convert(const double & s, long double & d) { d = s; }
-      static void Convert(const double & s, std::string & d)
-        { char buf[64]; sprintf(buf, sDoubleFormat, s); d = buf; }
 
-      static void Convert(const long double & s, bool & d) {
-        if (s < (long double)(Lim<bool>::min())) {
-          d = Lim<bool>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > (long double)(Lim<bool>::max())) {
-          d = Lim<bool>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (0.L != s); throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const long double & s, char & d) {
-        if (s < Lim<char>::min()) {
-          d = Lim<char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<char>::max()) {
-          d = Lim<char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (char) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const long double & s, signed char & d) {
-        if (s < Lim<signed char>::min()) {
-          d = Lim<signed char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<signed char>::max()) {
-          d = Lim<signed char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (signed char) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const long double & s, signed short & d) {
-        if (s < Lim<signed short>::min()) {
-          d = Lim<signed short>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<signed short>::max()) {
-          d = Lim<signed short>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (signed short) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
+      // Integer conversions to bool, or to a smaller type other than from
+      // unsigned to signed, can lose the value even when it is in range.
+      template <typename S, typename D>
+      static constexpr bool IsNarrowing() {
+        return std::is_same<D, bool>::value || (sizeof(D) < sizeof(S) &&
+          (Lim<S>::is_signed || !Lim<D>::is_signed || std::is_same<D, char>::value));
       }
-      static void Convert(const long double & s, signed int & d) {
-        if (s < Lim<signed int>::min()) {
-          d = Lim<signed int>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<signed int>::max()) {
-          d = Lim<signed int>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (signed int) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const long double & s, signed long & d) {
-        if (s < Lim<signed long>::min()) {
-          d = Lim<signed long>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<signed long>::max()) {
-          d = Lim<signed long>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (signed long) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const long double & s, unsigned char & d) {
-        if (s < Lim<unsigned char>::min()) {
-          d = Lim<unsigned char>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<unsigned char>::max()) {
-          d = Lim<unsigned char>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned char) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const long double & s, unsigned short & d) {
-        if (s < Lim<unsigned short>::min()) {
-          d = Lim<unsigned short>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<unsigned short>::max()) {
-          d = Lim<unsigned short>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned short) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const long double & s, unsigned int & d) {
-        if (s < Lim<unsigned int>::min()) {
-          d = Lim<unsigned int>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<unsigned int>::max()) {
-          d = Lim<unsigned int>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned int) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const long double & s, unsigned long & d) {
-        if (s < Lim<unsigned long>::min()) {
-          d = Lim<unsigned long>::min(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<unsigned long>::max()) {
-          d = Lim<unsigned long>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = (unsigned long) s; throw Hexception(P_PRECISION, "", __FILE__, __LINE__); }
-      }
-      static void Convert(const long double & s, float & d) {
-        if (s < -Lim<float>::max()) {
-          d = -Lim<float>::max(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<float>::max()) {
-          d = Lim<float>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = float(s); }
-      }
-      static void Convert(const long double & s, double & d) {
-        if (s < -Lim<double>::max()) {
-          d = -Lim<double>::max(); throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if (s > Lim<double>::max()) {
-          d = Lim<double>::max(); throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
-        } else { d = double(s); }
+
+      // Plain char is treated as having a different signedness from all other
+      // types, because that depends on the platform.
+      template <typename S, typename D>
+      static constexpr bool IsSignChange() {
+        return std::is_same<S, char>::value || std::is_same<D, char>::value ||
+          Lim<S>::is_signed != Lim<D>::is_signed;
       }
-      static void Convert(const long double & s, long double & d) { d = s; }
-      static void Convert(const long double & s, std::string & d)
-        { char buf[128]; sprintf(buf, sLongDoubleFormat, s); d = buf; }
 
-      static void Convert(const std::string & s, bool & d) {
+      static HexceptionCode_e TryConvert(const bool & s, std::string & d)
+        { if (s) d = "true"; else d = "false"; return P_OK; }
+      static HexceptionCode_e TryConvert(const char & s, std::string & d)
+        { FormatInteger(s, d); return P_OK; }
+      static HexceptionCode_e TryConvert(const signed char & s, std::string & d)
+        { FormatInteger(s, d); return P_OK; }
+      static HexceptionCode_e TryConvert(const signed short & s, std::string & d)
+        { FormatInteger(s, d); return P_OK; }
+      static HexceptionCode_e TryConvert(const signed int & s, std::string & d)
+        { FormatInteger(s, d); return P_OK; }
+      static HexceptionCode_e TryConvert(const signed long & s, std::string & d)
+        { FormatInteger(s, d); return P_OK; }
+      static HexceptionCode_e TryConvert(const signed long long & s, std::string & d)
+        { FormatInteger(s, d); return P_OK; }
+      static HexceptionCode_e TryConvert(const unsigned char & s, std::string & d)
+        { FormatInteger(s, d); return P_OK; }
+      static HexceptionCode_e TryConvert(const unsigned short & s, std::string & d)
+        { FormatInteger(s, d); return P_OK; }
+      static HexceptionCode_e TryConvert(const unsigned int & s, std::string & d)
+        { FormatInteger(s, d); return P_OK; }
+      static HexceptionCode_e TryConvert(const unsigned long & s, std::string & d)
+        { FormatInteger(s, d); return P_OK; }
+      static HexceptionCode_e TryConvert(const unsigned long long & s, std::string & d)
+        { FormatInteger(s, d); return P_OK; }
+      static HexceptionCode_e TryConvert(const float & s, std::string & d)
+        { FormatFloat(s, d); return P_OK; }
+      static HexceptionCode_e TryConvert(const double & s, std::string & d)
+        { FormatFloat(s, d); return P_OK; }
+      static HexceptionCode_e TryConvert(const long double & s, std::string & d)
+        { FormatFloat(s, d); return P_OK; }
+
+      static HexceptionCode_e TryConvert(const std::string & s, bool & d) {
         // Check for undefined values at the outset.
-        std::string s_uc(TrimSpaceUpperCase(s));
-        if (IsUndefined(s_uc)) {
-          throw Hexception(P_UNDEFINED, "", __FILE__, __LINE__);
+        if (P_UNDEFINED == SpecialValue(s)) {
+          return P_UNDEFINED;
         }
         if (!strcasecmp(s.c_str(), "yes") || !strcasecmp(s.c_str(), "y") ||
           !strcasecmp(s.c_str(), "true") || !strcasecmp(s.c_str(), "t") ||
@@ -846,334 +345,332 @@ namespace hoops {
           d = false;
           if (strcasecmp(s.c_str(), "no") && strcasecmp(s.c_str(), "n") &&
             strcasecmp(s.c_str(), "false") && strcasecmp(s.c_str(), "f") &&
-            strcasecmp(s.c_str(), "0")) throw Hexception(P_STR_INVALID, "", __FILE__, __LINE__);
+            strcasecmp(s.c_str(), "0")) return P_STR_INVALID;
         }
+        return P_OK;
       }
-      static void Convert(const std::string & s, char & d) {
+      static HexceptionCode_e TryConvert(const std::string & s, char & d) {
         // Check for infinite or undefined values at the outset.
-        std::string s_uc(TrimSpaceUpperCase(s));
-        if (IsInfinite(s_uc)) {
-          throw Hexception(P_INFINITE, "", __FILE__, __LINE__);
-        } else if (IsUndefined(s_uc)) {
-          throw Hexception(P_UNDEFINED, "", __FILE__, __LINE__);
-        }
-        char * r = 0;
-        errno = 0;
+        HexceptionCode_e special = SpecialValue(s);
+        if (P_OK != special) return special;
+        bool out_of_range = false;
         signed long tmpval; // Prevent spurious Visual Studio 7.0 compiler bug.
-        signed long val = strtol(s.c_str(), &r, 0);
-        if (ERANGE == errno) {
+        signed long val = 0;
+        const char * r = ParseSigned(s, val, out_of_range);
+        if (out_of_range) {
           d = Lim<char>::max();
-          throw Hexception(P_STR_OVERFLOW, "", __FILE__, __LINE__);
+          return P_STR_OVERFLOW;
         } else if (!IPrim::IsBlank(r)) {
           d = (char) val;
-          throw Hexception(P_STR_INVALID, "", __FILE__, __LINE__);
+          return P_STR_INVALID;
         } else if ((signed long) Lim<char>::min() > val) {
           d = Lim<char>::min();
-          throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
+          return P_UNDERFLOW;
         } else if ((tmpval = Lim<char>::max()) < val) {
           d = Lim<char>::max();
-          throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
+          return P_OVERFLOW;
         } else {
           d = (char) val;
-          if (val < Lim<unsigned char>::min()) throw Hexception(P_SIGNEDNESS, "", __FILE__, __LINE__);
+          if (val < Lim<unsigned char>::min()) return P_SIGNEDNESS;
         }
+        return P_OK;
       }
-      static void Convert(const std::string & s, signed char & d) {
+      static HexceptionCode_e TryConvert(const std::string & s, signed char & d) {
         // Check for infinite or undefined values at the outset.
-        std::string s_uc(TrimSpaceUpperCase(s));
-        if (IsInfinite(s_uc)) {
-          throw Hexception(P_INFINITE, "", __FILE__, __LINE__);
-        } else if (IsUndefined(s_uc)) {
-          throw Hexception(P_UNDEFINED, "", __FILE__, __LINE__);
-        }
-        char * r = 0;
-        errno = 0;
+        HexceptionCode_e special = SpecialValue(s);
+        if (P_OK != special) return special;
+        bool out_of_range = false;
         signed long tmpval; // Prevent spurious Visual Studio 7.0 compiler bug.
-        signed long val = strtol(s.c_str(), &r, 0);
-        if (ERANGE == errno) {
+        signed long val = 0;
+        const char * r = ParseSigned(s, val, out_of_range);
+        if (out_of_range) {
           d = Lim<signed char>::max();
-          throw Hexception(P_STR_OVERFLOW, "", __FILE__, __LINE__);
+          return P_STR_OVERFLOW;
         } else if (!IPrim::IsBlank(r)) {
           d = (signed char)(val);
-          throw Hexception(P_STR_INVALID, "", __FILE__, __LINE__);
+          return P_STR_INVALID;
         } else if (Lim<signed char>::min() > val) {
           d = Lim<signed char>::min();
-          throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
+          return P_UNDERFLOW;
         } else if ((tmpval = Lim<signed char>::max()) < val) {
           d = Lim<signed char>::max();
-          throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
+          return P_OVERFLOW;
         } else {
           d = (signed char)(val);
         }
+        return P_OK;
       }
-      static void Convert(const std::string & s, signed short & d) {
+      static HexceptionCode_e TryConvert(const std::string & s, signed short & d) {
         // Check for infinite or undefined values at the outset.
-        std::string s_uc(TrimSpaceUpperCase(s));
-        if (IsInfinite(s_uc)) {
-          throw Hexception(P_INFINITE, "", __FILE__, __LINE__);
-        } else if (IsUndefined(s_uc)) {
-          throw Hexception(P_UNDEFINED, "", __FILE__, __LINE__);
-        }
-        char * r = 0;
-        errno = 0;
+        HexceptionCode_e special = SpecialValue(s);
+        if (P_OK != special) return special;
+        bool out_of_range = false;
         signed long tmpval; // Prevent spurious Visual Studio 7.0 compiler bug.
-                signed long val = strtol(s.c_str(), &r, 0);
-        if (ERANGE == errno) {
+        signed long val = 0;
+        const char * r = ParseSigned(s, val, out_of_range);
+        if (out_of_range) {
           d = Lim<signed short>::max();
-          throw Hexception(P_STR_OVERFLOW, "", __FILE__, __LINE__);
+          return P_STR_OVERFLOW;
         } else if (!IPrim::IsBlank(r)) {
           d = (signed short)(val);
-          throw Hexception(P_STR_INVALID, "", __FILE__, __LINE__);
+          return P_STR_INVALID;
         } else if (Lim<signed short>::min() > val) {
           d = Lim<signed short>::min();
-          throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
+          return P_UNDERFLOW;
         } else if ((tmpval = Lim<signed short>::max()) < val) {
           d = Lim<signed short>::max();
-          throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
+          return P_OVERFLOW;
         } else {
           d = (signed short)(val);
         }
+        return P_OK;
       }
-      static void Convert(const std::string & s, signed int & d) {
+      static HexceptionCode_e TryConvert(const std::string & s, signed int & d) {
         // Check for infinite or undefined values at the outset.
-        std::string s_uc(TrimSpaceUpperCase(s));
-        if (IsInfinite(s_uc)) {
-          throw Hexception(P_INFINITE, "", __FILE__, __LINE__);
-        } else if (IsUndefined(s_uc)) {
-          throw Hexception(P_UNDEFINED, "", __FILE__, __LINE__);
-        }
-        char * r = 0;
-        errno = 0;
+        HexceptionCode_e special = SpecialValue(s);
+        if (P_OK != special) return special;
+        bool out_of_range = false;
         signed long tmpval; // Prevent spurious Visual Studio 7.0 compiler bug.
-        signed long val = strtol(s.c_str(), &r, 0);
-        if (ERANGE == errno) {
+        signed long val = 0;
+        const char * r = ParseSigned(s, val, out_of_range);
+        if (out_of_range) {
           d = Lim<signed int>::max();
-          throw Hexception(P_STR_OVERFLOW, "", __FILE__, __LINE__);
+          return P_STR_OVERFLOW;
         } else if (!IPrim::IsBlank(r)) {
           d = (signed int)(val);
-          throw Hexception(P_STR_INVALID, "", __FILE__, __LINE__);
+          return P_STR_INVALID;
         } else if (Lim<signed int>::min() > val) {
           d = Lim<signed int>::min();
-          throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
+          return P_UNDERFLOW;
         } else if ((tmpval = Lim<signed int>::max()) < val) {
           d = Lim<signed int>::max();
-          throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
+          return P_OVERFLOW;
         } else {
           d = (signed int)(val);
         }
+        return P_OK;
       }
-      static void Convert(const std::string & s, signed long & d) {
+      static HexceptionCode_e TryConvert(const std::string & s, signed long & d) {
         // Check for infinite or undefined values at the outset.
-        std::string s_uc(TrimSpaceUpperCase(s));
-        if (IsInfinite(s_uc)) {
-          throw Hexception(P_INFINITE, "", __FILE__, __LINE__);
-        } else if (IsUndefined(s_uc)) {
-          throw Hexception(P_UNDEFINED, "", __FILE__, __LINE__);
-        }
-        char * r = 0;
-        errno = 0;
-        signed long val = strtol(s.c_str(), &r, 0);
-        if (ERANGE == errno) {
-          d = Lim<signed short>::max();
-          throw Hexception(P_STR_OVERFLOW, "", __FILE__, __LINE__);
+        HexceptionCode_e special = SpecialValue(s);
+        if (P_OK != special) return special;
+        bool out_of_range = false;
+        signed long val = 0;
+        const char * r = ParseSigned(s, val, out_of_range);
+        if (out_of_range) {
+          d = val;
+          return P_STR_OVERFLOW;
         } else if (!IPrim::IsBlank(r)) {
           d = val;
-          throw Hexception(P_STR_INVALID, "", __FILE__, __LINE__);
+          return P_STR_INVALID;
         } else {
           d = val;
         }
+        return P_OK;
       }
-      static void Convert(const std::string & s, unsigned char & d) {
+      static HexceptionCode_e TryConvert(const std::string & s, signed long long & d) {
         // Check for infinite or undefined values at the outset.
-        std::string s_uc(TrimSpaceUpperCase(s));
-        if (IsInfinite(s_uc)) {
-          throw Hexception(P_INFINITE, "", __FILE__, __LINE__);
-        } else if (IsUndefined(s_uc)) {
-          throw Hexception(P_UNDEFINED, "", __FILE__, __LINE__);
+        HexceptionCode_e special = SpecialValue(s);
+        if (P_OK != special) return special;
+        bool out_of_range = false;
+        signed long long val = 0;
+        const char * r = ParseSigned(s, val, out_of_range);
+        if (out_of_range) {
+          d = val;
+          return P_STR_OVERFLOW;
+        } else if (!IPrim::IsBlank(r)) {
+          d = val;
+          return P_STR_INVALID;
+        } else {
+          d = val;
         }
-        char * r = 0;
-        errno = 0;
+        return P_OK;
+      }
+      static HexceptionCode_e TryConvert(const std::string & s, unsigned char & d) {
+        // Check for infinite or undefined values at the outset.
+        HexceptionCode_e special = SpecialValue(s);
+        if (P_OK != special) return special;
+        bool out_of_range = false;
         unsigned long tmpval; // Prevent spurious Visual Studio 7.0 compiler bug.
-        unsigned long val = strtoul(s.c_str(), &r, 0);
-        if (ERANGE == errno) {
+        unsigned long val = 0;
+        const char * r = ParseUnsigned(s, val, out_of_range);
+        if (out_of_range) {
           d = Lim<unsigned char>::max();
-          throw Hexception(P_STR_OVERFLOW, "", __FILE__, __LINE__);
+          return P_STR_OVERFLOW;
         } else if (!IPrim::IsBlank(r)) {
           d = (unsigned char)(val);
-          throw Hexception(P_STR_INVALID, "", __FILE__, __LINE__);
+          return P_STR_INVALID;
         } else if (Lim<unsigned char>::min() > val) {
           d = Lim<unsigned char>::min();
-          throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
+          return P_UNDERFLOW;
         } else if ((tmpval = Lim<unsigned char>::max()) < val) {
           d = Lim<unsigned char>::max();
-          throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
+          return P_OVERFLOW;
         } else {
           d = (unsigned char)(val);
         }
+        return P_OK;
       }
-      static void Convert(const std::string & s, unsigned short & d) {
+      static HexceptionCode_e TryConvert(const std::string & s, unsigned short & d) {
         // Check for infinite or undefined values at the outset.
-        std::string s_uc(TrimSpaceUpperCase(s));
-        if (IsInfinite(s_uc)) {
-          throw Hexception(P_INFINITE, "", __FILE__, __LINE__);
-        } else if (IsUndefined(s_uc)) {
-          throw Hexception(P_UNDEFINED, "", __FILE__, __LINE__);
-        }
-        char * r = 0;
-        errno = 0;
+        HexceptionCode_e special = SpecialValue(s);
+        if (P_OK != special) return special;
+        bool out_of_range = false;
         unsigned long tmpval; // Prevent spurious Visual Studio 7.0 compiler bug.
-        unsigned long val = strtoul(s.c_str(), &r, 0);
-        if (ERANGE == errno) {
+        unsigned long val = 0;
+        const char * r = ParseUnsigned(s, val, out_of_range);
+        if (out_of_range) {
           d = Lim<unsigned short>::max();
-          throw Hexception(P_STR_OVERFLOW, "", __FILE__, __LINE__);
+          return P_STR_OVERFLOW;
         } else if (!IPrim::IsBlank(r)) {
           d = (unsigned short)(val);
-          throw Hexception(P_STR_INVALID, "", __FILE__, __LINE__);
+          return P_STR_INVALID;
         } else if (Lim<unsigned short>::min() > val) {
           d = Lim<unsigned short>::min();
-          throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
+          return P_UNDERFLOW;
         } else if ((tmpval = Lim<unsigned short>::max()) < val) {
           d = Lim<unsigned short>::max();
-          throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
+          return P_OVERFLOW;
         } else {
           d = (unsigned short)(val);
         }
+        return P_OK;
       }
-      static void Convert(const std::string & s, unsigned int & d) {
+      static HexceptionCode_e TryConvert(const std::string & s, unsigned int & d) {
         // Check for infinite or undefined values at the outset.
-        std::string s_uc(TrimSpaceUpperCase(s));
-        if (IsInfinite(s_uc)) {
-          throw Hexception(P_INFINITE, "", __FILE__, __LINE__);
-        } else if (IsUndefined(s_uc)) {
-          throw Hexception(P_UNDEFINED, "", __FILE__, __LINE__);
-        }
-        char * r = 0;
-        errno = 0;
+        HexceptionCode_e special = SpecialValue(s);
+        if (P_OK != special) return special;
+        bool out_of_range = false;
         unsigned long tmpval; // Prevent spurious Visual Studio 7.0 compiler bug.
-        unsigned long val = strtoul(s.c_str(), &r, 0);
-        if (ERANGE == errno) {
+        unsigned long val = 0;
+        const char * r = ParseUnsigned(s, val, out_of_range);
+        if (out_of_range) {
           d = Lim<unsigned int>::max();
-          throw Hexception(P_STR_OVERFLOW, "", __FILE__, __LINE__);
+          return P_STR_OVERFLOW;
         } else if (!IPrim::IsBlank(r)) {
           d = (unsigned int)(val);
-          throw Hexception(P_STR_INVALID, "", __FILE__, __LINE__);
+          return P_STR_INVALID;
         } else if (Lim<unsigned int>::min() > val) {
           d = Lim<unsigned int>::min();
-          throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
+          return P_UNDERFLOW;
         } else if ((tmpval = Lim<unsigned int>::max()) < val) {
           d = Lim<unsigned int>::max();
-          throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
+          return P_OVERFLOW;
         } else {
           d = (unsigned int)(val);
         }
+        return P_OK;
       }
-      static void Convert(const std::string & s, unsigned long & d) {
+      static HexceptionCode_e TryConvert(const std::string & s, unsigned long & d) {
         // Check for infinite or undefined values at the outset.
-        std::string s_uc(TrimSpaceUpperCase(s));
-        if (IsInfinite(s_uc)) {
-          throw Hexception(P_INFINITE, "", __FILE__, __LINE__);
-        } else if (IsUndefined(s_uc)) {
-          throw Hexception(P_UNDEFINED, "", __FILE__, __LINE__);
-        }
-        char * r = 0;
-        errno = 0;
-        unsigned long val = strtoul(s.c_str(), &r, 0);
-        if (ERANGE == errno) {
+        HexceptionCode_e special = SpecialValue(s);
+        if (P_OK != special) return special;
+        bool out_of_range = false;
+        unsigned long val = 0;
+        const char * r = ParseUnsigned(s, val, out_of_range);
+        if (out_of_range) {
           d = Lim<unsigned long>::max();
-          throw Hexception(P_STR_OVERFLOW, "", __FILE__, __LINE__);
+          return P_STR_OVERFLOW;
         } else if (!IPrim::IsBlank(r)) {
           d = val;
-          throw Hexception(P_STR_INVALID, "", __FILE__, __LINE__);
+          return P_STR_INVALID;
         } else {
           d = val;
         }
+        return P_OK;
       }
-      static void Convert(const std::string & s, float & d) {
+      static HexceptionCode_e TryConvert(const std::string & s, unsigned long long & d) {
         // Check for infinite or undefined values at the outset.
-        std::string s_uc(TrimSpaceUpperCase(s));
-        if (IsInfinite(s_uc)) {
-          throw Hexception(P_INFINITE, "", __FILE__, __LINE__);
-        } else if (IsUndefined(s_uc)) {
-          throw Hexception(P_UNDEFINED, "", __FILE__, __LINE__);
-        }
-        char * r = 0;
-        errno = 0;
-        double tmpval; // Prevent spurious Visual Studio 7.0 compiler bug.
-        double val = strtod(s.c_str(), &r);
-        if (ERANGE == errno) {
-          d = Lim<float>::max();
-          throw Hexception(P_STR_OVERFLOW, "", __FILE__, __LINE__);
+        HexceptionCode_e special = SpecialValue(s);
+        if (P_OK != special) return special;
+        bool out_of_range = false;
+        unsigned long long val = 0;
+        const char * r = ParseUnsigned(s, val, out_of_range);
+        if (out_of_range) {
+          d = Lim<unsigned long long>::max();
+          return P_STR_OVERFLOW;
         } else if (!IPrim::IsBlank(r)) {
-          d = float(val);
-          throw Hexception(P_STR_INVALID, "", __FILE__, __LINE__);
-        } else if (-Lim<float>::max() > val) {
-          d = -Lim<float>::max();
-          throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
-        } else if ((tmpval = Lim<float>::max()) < val) {
-          d = Lim<float>::max();
-          throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
+          d = val;
+          return P_STR_INVALID;
         } else {
-          d = float(val);
+          d = val;
         }
+        return P_OK;
       }
-      static void Convert(const std::string & s, double & d) {
+      static HexceptionCode_e TryConvert(const std::string & s, float & d) {
         // Check for infinite or undefined values at the outset.
-        std::string s_uc(TrimSpaceUpperCase(s));
-        if (IsInfinite(s_uc)) {
-          throw Hexception(P_INFINITE, "", __FILE__, __LINE__);
-        } else if (IsUndefined(s_uc)) {
-          throw Hexception(P_UNDEFINED, "", __FILE__, __LINE__);
+        HexceptionCode_e special = SpecialValue(s);
+        if (P_OK != special) return special;
+        bool out_of_range = false;
+        float val = 0.f;
+        const char * r = ParseFloat(s, val, out_of_range);
+        HexceptionCode_e status = P_OK;
+        if (out_of_range) {
+          // Too large for float, or so small it is 0. Values which double can
+          // hold are reported as over- or underflow rather than as strings
+          // which cannot be read.
+          double wide = 0.;
+          r = ParseFloat(s, wide, out_of_range);
+          if (out_of_range) {
+            d = Lim<float>::max();
+            return P_STR_OVERFLOW;
+          } else if (-Lim<float>::max() > wide) {
+            val = -Lim<float>::max();
+            status = P_UNDERFLOW;
+          } else if (Lim<float>::max() < wide) {
+            val = Lim<float>::max();
+            status = P_OVERFLOW;
+          }
         }
-        char * r = 0;
-        errno = 0;
-        double val = strtod(s.c_str(), &r);
-        if (ERANGE == errno) {
+        d = val;
+        if (!IPrim::IsBlank(r)) return P_STR_INVALID;
+        return status;
+      }
+      static HexceptionCode_e TryConvert(const std::string & s, double & d) {
+        // Check for infinite or undefined values at the outset.
+        HexceptionCode_e special = SpecialValue(s);
+        if (P_OK != special) return special;
+        bool out_of_range = false;
+        double val = 0.;
+        const char * r = ParseFloat(s, val, out_of_range);
+        if (out_of_range) {
           d = Lim<double>::max();
-          throw Hexception(P_STR_OVERFLOW, "", __FILE__, __LINE__);
+          return P_STR_OVERFLOW;
         } else if (!IPrim::IsBlank(r)) {
           d = val;
-          throw Hexception(P_STR_INVALID, "", __FILE__, __LINE__);
+          return P_STR_INVALID;
         } else {
           d = val;
         }
+        return P_OK;
       }
-      static void Convert(const std::string & s, long double & d) {
+      static HexceptionCode_e TryConvert(const std::string & s, long double & d) {
         // Check for infinite or undefined values at the outset.
-        std::string s_uc(TrimSpaceUpperCase(s));
-        if (IsInfinite(s_uc)) {
-          throw Hexception(P_INFINITE, "", __FILE__, __LINE__);
-        } else if (IsUndefined(s_uc)) {
-          throw Hexception(P_UNDEFINED, "", __FILE__, __LINE__);
-        }
-        char * r = 0;
-        errno = 0;
-        double val = strtod(s.c_str(), &r);
-        if (ERANGE == errno) {
+        HexceptionCode_e special = SpecialValue(s);
+        if (P_OK != special) return special;
+        bool out_of_range = false;
+        long double val = 0.L;
+        const char * r = ParseFloat(s, val, out_of_range);
+        if (out_of_range) {
           d = Lim<long double>::max();
-          throw Hexception(P_STR_OVERFLOW, "", __FILE__, __LINE__);
+          return P_STR_OVERFLOW;
         } else if (!IPrim::IsBlank(r)) {
           d = val;
-          throw Hexception(P_STR_INVALID, "", __FILE__, __LINE__);
+          return P_STR_INVALID;
         } else {
           d = val;
         }
+        return P_OK;
       }
-      static void Convert(const std::string & s, std::string & d) { d = s; }
-      static bool sThrowBadSize;
-
-      static const char * const sFloatFormat;
-      static const char * const sDoubleFormat;
-      static const char * const sLongDoubleFormat;
+      static HexceptionCode_e TryConvert(const std::string & s, std::string & d) { d = s; return P_OK; }
+      // Whether narrowing integer conversions report P_BADSIZE; they do not.
+      static constexpr bool sThrowBadSize = false;
 
   };
 
   //////////////////////////////////////////////////////////////////////////////
   // Static variable definitions.
   //////////////////////////////////////////////////////////////////////////////
-  bool Conv::sThrowBadSize = false;
-  const char * const Conv::sFloatFormat = float_format();
-  const char * const Conv::sDoubleFormat = double_format();
-  const char * const Conv::sLongDoubleFormat = long_double_format();
   //////////////////////////////////////////////////////////////////////////////
 
 
@@ -1195,10 +692,12 @@ namespace hoops {
       virtual void From(const signed short & x) { Conv::Convert(x, mData); }
       virtual void From(const signed int & x) { Conv::Convert(x, mData); }
       virtual void From(const signed long & x) { Conv::Convert(x, mData); }
+      virtual void From(const signed long long & x) { Conv::Convert(x, mData); }
       virtual void From(const unsigned char & x) { Conv::Convert(x, mData); }
       virtual void From(const unsigned short & x) { Conv::Convert(x, mData); }
       virtual void From(const unsigned int & x) { Conv::Convert(x, mData); }
       virtual void From(const unsigned long & x) { Conv::Convert(x, mData); }
+      virtual void From(const unsigned long long & x) { Conv::Convert(x, mData); }
       virtual void From(const float & x) { Conv::Convert(x, mData); }
       virtual void From(const double & x) { Conv::Convert(x, mData); }
       virtual void From(const long double & x) { Conv::Convert(x, mData); }
@@ -1211,15 +710,53 @@ namespace hoops {
       virtual void To(signed short & x) const { Conv::Convert(mData, x); }
       virtual void To(signed int & x) const { Conv::Convert(mData, x); }
       virtual void To(signed long & x) const { Conv::Convert(mData, x); }
+      virtual void To(signed long long & x) const { Conv::Convert(mData, x); }
       virtual void To(unsigned char & x) const { Conv::Convert(mData, x); }
       virtual void To(unsigned short & x) const { Conv::Convert(mData, x); }
       virtual void To(unsigned int & x) const { Conv::Convert(mData, x); }
       virtual void To(unsigned long & x) const { Conv::Convert(mData, x); }
+      virtual void To(unsigned long long & x) const { Conv::Convert(mData, x); }
       virtual void To(float & x) const { Conv::Convert(mData, x); }
       virtual void To(double & x) const { Conv::Convert(mData, x); }
       virtual void To(long double & x) const { Conv::Convert(mData, x); }
       virtual void To(std::string & x) const { Conv::Convert(mData, x); }
 
+      virtual HexceptionCode_e TryFrom(const IPrim & x) { return x.TryTo(mData); }
+      virtual HexceptionCode_e TryFrom(const bool & x) { return Conv::TryConvert(x, mData); }
+      virtual HexceptionCode_e TryFrom(const char & x) { return Conv::TryConvert(x, mData); }
+      virtual HexceptionCode_e TryFrom(const signed char & x) { return Conv::TryConvert(x, mData); }
+      virtual HexceptionCode_e TryFrom(const signed short & x) { return Conv::TryConvert(x, mData); }
+      virtual HexceptionCode_e TryFrom(const signed int & x) { return Conv::TryConvert(x, mData); }
+      virtual HexceptionCode_e TryFrom(const signed long & x) { return Conv::TryConvert(x, mData); }
+      virtual HexceptionCode_e TryFrom(const signed long long & x) { return Conv::TryConvert(x, mData); }
+      virtual HexceptionCode_e TryFrom(const unsigned char & x) { return Conv::TryConvert(x, mData); }
+      virtual HexceptionCode_e TryFrom(const unsigned short & x) { return Conv::TryConvert(x, mData); }
+      virtual HexceptionCode_e TryFrom(const unsigned int & x) { return Conv::TryConvert(x, mData); }
+      virtual HexceptionCode_e TryFrom(const unsigned long & x) { return Conv::TryConvert(x, mData); }
+      virtual HexceptionCode_e TryFrom(const unsigned long long & x) { return Conv::TryConvert(x, mData); }
+      virtual HexceptionCode_e TryFrom(const float & x) { return Conv::TryConvert(x, mData); }
+      virtual HexceptionCode_e TryFrom(const double & x) { return Conv::TryConvert(x, mData); }
+      virtual HexceptionCode_e TryFrom(const long double & x) { return Conv::TryConvert(x, mData); }
+      virtual HexceptionCode_e TryFrom(const std::string & x) { return Conv::TryConvert(x, mData); }
+
+      virtual HexceptionCode_e TryTo(IPrim & x) const { return x.TryFrom(mData); }
+      virtual HexceptionCode_e TryTo(bool & x) const { return Conv::TryConvert(mData, x); }
+      virtual HexceptionCode_e TryTo(char & x) const { return Conv::TryConvert(mData, x); }
+      virtual HexceptionCode_e TryTo(signed char & x) const { return Conv::TryConvert(mData, x); }
+      virtual HexceptionCode_e TryTo(signed short & x) const { return Conv::TryConvert(mData, x); }
+      virtual HexceptionCode_e TryTo(signed int & x) const { return Conv::TryConvert(mData, x); }
+      virtual HexceptionCode_e TryTo(signed long & x) const { return Conv::TryConvert(mData, x); }
+      virtual HexceptionCode_e TryTo(signed long long & x) const { return Conv::TryConvert(mData, x); }
+      virtual HexceptionCode_e TryTo(unsigned char & x) const { return Conv::TryConvert(mData, x); }
+      virtual HexceptionCode_e TryTo(unsigned short & x) const { return Conv::TryConvert(mData, x); }
+      virtual HexceptionCode_e TryTo(unsigned int & x) const { return Conv::TryConvert(mData, x); }
+      virtual HexceptionCode_e TryTo(unsigned long & x) const { return Conv::TryConvert(mData, x); }
+      virtual HexceptionCode_e TryTo(unsigned long long & x) const { return Conv::TryConvert(mData, x); }
+      virtual HexceptionCode_e TryTo(float & x) const { return Conv::TryConvert(mData, x); }
+      virtual HexceptionCode_e TryTo(double & x) const { return Conv::TryConvert(mData, x); }
+      virtual HexceptionCode_e TryTo(long double & x) const { return Conv::TryConvert(mData, x); }
+      virtual HexceptionCode_e TryTo(std::string & x) const { return Conv::TryConvert(mData, x); }
+
       virtual std::string StringData() const throw()
         { std::string r; To(r); return r; }
 
@@ -1229,6 +766,27 @@ namespace hoops {
       T mData;
   };
 
+  //////////////////////////////////////////////////////////////////////////////
+  // Begin IPrim implementation.
+  //////////////////////////////////////////////////////////////////////////////
+  void IPrim::From(const signed long long & x) { From(ToLong(x)); }
+
+  void IPrim::From(const unsigned long long & x) { From(ToULong(x)); }
+
+  void IPrim::To(signed long long & x) const { signed long r = 0; To(r); x = r; }
+
+  void IPrim::To(unsigned long long & x) const { unsigned long r = 0; To(r); x = r; }
+  //////////////////////////////////////////////////////////////////////////////
+  // End IPrim implementation.
+  //////////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+  IPrim * IPrimFactory::NewIPrim(const signed long long & p) const
+    { return NewIPrim(ToLong(p)); }
+  IPrim * IPrimFactory::NewIPrim(const unsigned long long & p) const
+    { return NewIPrim(ToULong(p)); }
+  //////////////////////////////////////////////////////////////////////////////
+
   //////////////////////////////////////////////////////////////////////////////
   IPrim * PrimFactory::NewIPrim(const bool & p) const
     { return new Prim<bool>(p); }
@@ -1242,6 +800,8 @@ namespace hoops {
     { return new Prim<signed int>(p); }
   IPrim * PrimFactory::NewIPrim(const signed long & p) const
     { return new Prim<signed long>(p); }
+  IPrim * PrimFactory::NewIPrim(const signed long long & p) const
+    { return new Prim<signed long long>(p); }
   IPrim * PrimFactory::NewIPrim(const unsigned char & p) const
     { return new Prim<unsigned char>(p); }
   IPrim * PrimFactory::NewIPrim(const unsigned short & p) const
@@ -1250,6 +810,8 @@ namespace hoops {
     { return new Prim<unsigned int>(p); }
   IPrim * PrimFactory::NewIPrim(const unsigned long & p) const
     { return new Prim<unsigned long>(p); }
+  IPrim * PrimFactory::NewIPrim(const unsigned long long & p) const
+    { return new Prim<unsigned long long>(p); }
   IPrim * PrimFactory::NewIPrim(const float & p) const
     { return new Prim<float>(p); }
   IPrim * PrimFactory::NewIPrim(const double & p) const
@@ -1260,6 +822,131 @@ namespace hoops {
     { return new Prim<std::string>(p); }
   //////////////////////////////////////////////////////////////////////////////
 
+  //////////////////////////////////////////////////////////////////////////////
+  // Begin PrimUnion implementation.
+  //////////////////////////////////////////////////////////////////////////////
+  // Convert s to whichever type d holds.
+  template <typename S>
+  static HexceptionCode_e TryConvertTo(const S & s, PrimUnion::Data_t & d)
+    { return std::visit([&s](auto & value) { return Conv::TryConvert(s, value); }, d); }
+
+  // Convert whichever type s holds to d.
+  template <typename D>
+  static HexceptionCode_e TryConvertFrom(const PrimUnion::Data_t & s, D & d)
+    { return std::visit([&d](const auto & value) { return Conv::TryConvert(value, d); }, s); }
+
+  static void ThrowIfError(HexceptionCode_e status)
+    { if (P_OK != status && !WarningSink::Take(status)) throw Hexception(status, "", __FILE__, __LINE__); }
+
+  PrimUnion::PrimUnion(): IPrim(), mData() {}
+
+  PrimUnion::PrimUnion(Type_e type): IPrim(), mData() { SetType(type); }
+
+  PrimUnion::PrimUnion(const PrimUnion & p): IPrim(), mData(p.mData) {}
+
+  PrimUnion::PrimUnion(PrimUnion && p) noexcept: IPrim(), mData(std::move(p.mData)) {}
+
+  PrimUnion::~PrimUnion() {}
+
+  PrimUnion & PrimUnion::operator =(const PrimUnion & p) { mData = p.mData; return *this; }
+
+  PrimUnion & PrimUnion::operator =(PrimUnion && p) noexcept { mData = std::move(p.mData); return *this; }
+
+  void PrimUnion::SetType(Type_e type) {
+    switch (type) {
+      case eBool: mData = bool(); break;
+      case eLong: mData = Long_t(); break;
+      case eDouble: mData = double(); break;
+      case eString: mData = std::string(); break;
+    }
+  }
+
+  void PrimUnion::From(const IPrim & x) { ThrowIfError(TryFrom(x)); }
+  void PrimUnion::From(const bool & x) { ThrowIfError(TryConvertTo(x, mData)); }
+  void PrimUnion::From(const char & x) { ThrowIfError(TryConvertTo(x, mData)); }
+  void PrimUnion::From(const signed char & x) { ThrowIfError(TryConvertTo(x, mData)); }
+  void PrimUnion::From(const signed short & x) { ThrowIfError(TryConvertTo(x, mData)); }
+  void PrimUnion::From(const signed int & x) { ThrowIfError(TryConvertTo(x, mData)); }
+  void PrimUnion::From(const signed long & x) { ThrowIfError(TryConvertTo(x, mData)); }
+  void PrimUnion::From(const signed long long & x) { ThrowIfError(TryConvertTo(x, mData)); }
+  void PrimUnion::From(const unsigned char & x) { ThrowIfError(TryConvertTo(x, mData)); }
+  void PrimUnion::From(const unsigned short & x) { ThrowIfError(TryConvertTo(x, mData)); }
+  void PrimUnion::From(const unsigned int & x) { ThrowIfError(TryConvertTo(x, mData)); }
+  void PrimUnion::From(const unsigned long & x) { ThrowIfError(TryConvertTo(x, mData)); }
+  void PrimUnion::From(const unsigned long long & x) { ThrowIfError(TryConvertTo(x, mData)); }
+  void PrimUnion::From(const float & x) { ThrowIfError(TryConvertTo(x, mData)); }
+  void PrimUnion::From(const double & x) { ThrowIfError(TryConvertTo(x, mData)); }
+  void PrimUnion::From(const long double & x) { ThrowIfError(TryConvertTo(x, mData)); }
+  void PrimUnion::From(const std::string & x) { ThrowIfError(TryConvertTo(x, mData)); }
+  void PrimUnion::From(std::string && x) {
+    if (std::string * value = std::get_if<std::string>(&mData)) *value = std::move(x);
+    else PrimUnion::From(static_cast<const std::string &>(x));
+  }
+
+  void PrimUnion::To(IPrim & x) const { ThrowIfError(TryTo(x)); }
+  void PrimUnion::To(bool & x) const { ThrowIfError(TryConvertFrom(mData, x)); }
+  void PrimUnion::To(char & x) const { ThrowIfError(TryConvertFrom(mData, x)); }
+  void PrimUnion::To(signed char & x) const { ThrowIfError(TryConvertFrom(mData, x)); }
+  void PrimUnion::To(signed short & x) const { ThrowIfError(TryConvertFrom(mData, x)); }
+  void PrimUnion::To(signed int & x) const { ThrowIfError(TryConvertFrom(mData, x)); }
+  void PrimUnion::To(signed long & x) const { ThrowIfError(TryConvertFrom(mData, x)); }
+  void PrimUnion::To(signed long long & x) const { ThrowIfError(TryConvertFrom(mData, x)); }
+  void PrimUnion::To(unsigned char & x) const { ThrowIfError(TryConvertFrom(mData, x)); }
+  void PrimUnion::To(unsigned short & x) const { ThrowIfError(TryConvertFrom(mData, x)); }
+  void PrimUnion::To(unsigned int & x) const { ThrowIfError(TryConvertFrom(mData, x)); }
+  void PrimUnion::To(unsigned long & x) const { ThrowIfError(TryConvertFrom(mData, x)); }
+  void PrimUnion::To(unsigned long long & x) const { ThrowIfError(TryConvertFrom(mData, x)); }
+  void PrimUnion::To(float & x) const { ThrowIfError(TryConvertFrom(mData, x)); }
+  void PrimUnion::To(double & x) const { ThrowIfError(TryConvertFrom(mData, x)); }
+  void PrimUnion::To(long double & x) const { ThrowIfError(TryConvertFrom(mData, x)); }
+  void PrimUnion::To(std::string & x) const { ThrowIfError(TryConvertFrom(mData, x)); }
+
+  HexceptionCode_e PrimUnion::TryFrom(const IPrim & x)
+    { return std::visit([&x](auto & value) { return x.TryTo(value); }, mData); }
+  HexceptionCode_e PrimUnion::TryFrom(const bool & x) { return TryConvertTo(x, mData); }
+  HexceptionCode_e PrimUnion::TryFrom(const char & x) { return TryConvertTo(x, mData); }
+  HexceptionCode_e PrimUnion::TryFrom(const signed char & x) { return TryConvertTo(x, mData); }
+  HexceptionCode_e PrimUnion::TryFrom(const signed short & x) { return TryConvertTo(x, mData); }
+  HexceptionCode_e PrimUnion::TryFrom(const signed int & x) { return TryConvertTo(x, mData); }
+  HexceptionCode_e PrimUnion::TryFrom(const signed long & x) { return TryConvertTo(x, mData); }
+  HexceptionCode_e PrimUnion::TryFrom(const signed long long & x) { return TryConvertTo(x, mData); }
+  HexceptionCode_e PrimUnion::TryFrom(const unsigned char & x) { return TryConvertTo(x, mData); }
+  HexceptionCode_e PrimUnion::TryFrom(const unsigned short & x) { return TryConvertTo(x, mData); }
+  HexceptionCode_e PrimUnion::TryFrom(const unsigned int & x) { return TryConvertTo(x, mData); }
+  HexceptionCode_e PrimUnion::TryFrom(const unsigned long & x) { return TryConvertTo(x, mData); }
+  HexceptionCode_e PrimUnion::TryFrom(const unsigned long long & x) { return TryConvertTo(x, mData); }
+  HexceptionCode_e PrimUnion::TryFrom(const float & x) { return TryConvertTo(x, mData); }
+  HexceptionCode_e PrimUnion::TryFrom(const double & x) { return TryConvertTo(x, mData); }
+  HexceptionCode_e PrimUnion::TryFrom(const long double & x) { return TryConvertTo(x, mData); }
+  HexceptionCode_e PrimUnion::TryFrom(const std::string & x) { return TryConvertTo(x, mData); }
+
+  HexceptionCode_e PrimUnion::TryTo(IPrim & x) const
+    { return std::visit([&x](const auto & value) { return x.TryFrom(value); }, mData); }
+  HexceptionCode_e PrimUnion::TryTo(bool & x) const { return TryConvertFrom(mData, x); }
+  HexceptionCode_e PrimUnion::TryTo(char & x) const { return TryConvertFrom(mData, x); }
+  HexceptionCode_e PrimUnion::TryTo(signed char & x) const { return TryConvertFrom(mData, x); }
+  HexceptionCode_e PrimUnion::TryTo(signed short & x) const { return TryConvertFrom(mData, x); }
+  HexceptionCode_e PrimUnion::TryTo(signed int & x) const { return TryConvertFrom(mData, x); }
+  HexceptionCode_e PrimUnion::TryTo(signed long & x) const { return TryConvertFrom(mData, x); }
+  HexceptionCode_e PrimUnion::TryTo(signed long long & x) const { return TryConvertFrom(mData, x); }
+  HexceptionCode_e PrimUnion::TryTo(unsigned char & x) const { return TryConvertFrom(mData, x); }
+  HexceptionCode_e PrimUnion::TryTo(unsigned short & x) const { return TryConvertFrom(mData, x); }
+  HexceptionCode_e PrimUnion::TryTo(unsigned int & x) const { return TryConvertFrom(mData, x); }
+  HexceptionCode_e PrimUnion::TryTo(unsigned long & x) const { return TryConvertFrom(mData, x); }
+  HexceptionCode_e PrimUnion::TryTo(unsigned long long & x) const { return TryConvertFrom(mData, x); }
+  HexceptionCode_e PrimUnion::TryTo(float & x) const { return TryConvertFrom(mData, x); }
+  HexceptionCode_e PrimUnion::TryTo(double & x) const { return TryConvertFrom(mData, x); }
+  HexceptionCode_e PrimUnion::TryTo(long double & x) const { return TryConvertFrom(mData, x); }
+  HexceptionCode_e PrimUnion::TryTo(std::string & x) const { return TryConvertFrom(mData, x); }
+
+  std::string PrimUnion::StringData() const
+    { std::string r; To(r); return r; }
+
+  IPrim * PrimUnion::Clone() const { return new PrimUnion(*this); }
+  //////////////////////////////////////////////////////////////////////////////
+  // End PrimUnion implementation.
+  //////////////////////////////////////////////////////////////////////////////
+
   //////////////////////////////////////////////////////////////////////////////
   // Global variable definitions.
   //////////////////////////////////////////////////////////////////////////////
@@ -1283,22 +970,20 @@ namespace hoops {
   }
 #endif
 
-  static const char * float_format() {
-    static char r[16];
-    sprintf(r, "%%1.%dg", Lim<float>::digits10);
-    return r;
-  }
-  static const char * double_format() {
-    static char r[16];
-    sprintf(r, "%%1.%dg", Lim<double>::digits10);
-    return r;
-  }
-  static const char * long_double_format() {
-    static char r[16];
-    sprintf(r, "%%1.%dLg", Lim<long double>::digits10);
-    return r;
+  // Utility ToLong: x as a long, or throw P_OVERFLOW or P_UNDERFLOW if long
+  // cannot hold it.
+  static long ToLong(const long long & x) {
+    if (Lim<long>::max() < x) throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
+    if (Lim<long>::min() > x) throw Hexception(P_UNDERFLOW, "", __FILE__, __LINE__);
+    return long(x);
   }
 
+  // Utility ToULong: x as an unsigned long, or throw P_OVERFLOW if unsigned
+  // long cannot hold it.
+  static unsigned long ToULong(const unsigned long long & x) {
+    if (Lim<unsigned long>::max() < x) throw Hexception(P_OVERFLOW, "", __FILE__, __LINE__);
+    return (unsigned long)(x);
+  }
   //////////////////////////////////////////////////////////////////////////////
 
   //////////////////////////////////////////////////////////////////////////////
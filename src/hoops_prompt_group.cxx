@@ -16,9 +16,11 @@
 // C++ header files.
 ////////////////////////////////////////////////////////////////////////////////
 #include "hoops/hoops.h"
+#include "hoops/hoops_ape.h"
 #include "hoops/hoops_ape_factory.h"
 #include "hoops/hoops_group.h"
 #include "hoops/hoops_prompt_group.h"
+#include <utility>
 ////////////////////////////////////////////////////////////////////////////////
 
 #ifndef EXPSYM
@@ -42,13 +44,14 @@ namespace hoops {
   ParPromptGroup::ParPromptGroup(int argc, char * argv[],
     const std::string & comp_name): IParGroup(), mFile(0),
     mPrompter(0) {
-    // Use comp_name if one was supplied to find the parameter file, otherwise
-    // use argv[0].
-    if (comp_name.empty()) mFile = HoopsApeFileFactory().NewIParFile(argv[0]);
-    else mFile = HoopsApeFileFactory().NewIParFile(comp_name);
+    // Create a new prompter object. This loads the parameter file (using
+    // comp_name if one was supplied, otherwise argv[0]) once.
+    HoopsApePrompt * prompter = new HoopsApePrompt(argc, argv, comp_name);
+    mPrompter = prompter;
 
-    // Create a new prompter object:
-    mPrompter = HoopsApePromptFactory().NewIParPrompt(argc, argv, comp_name);
+    // The file object copies the prompter's parameters and shares its ape
+    // session, rather than loading the file again.
+    mFile = new HoopsApeFile(prompter->File());
 
     // Get a reference to the prompter's group:
     mGroup = &mPrompter->Group();
@@ -61,6 +64,13 @@ namespace hoops {
     mGroup = &mPrompter->Group();
   }
 
+  ParPromptGroup::ParPromptGroup(ParPromptGroup && group) noexcept: IParGroup(),
+    mFile(group.mFile), mPrompter(group.mPrompter), mGroup(group.mGroup) {
+    group.mFile = 0;
+    group.mPrompter = 0;
+    group.mGroup = 0;
+  }
+
   ParPromptGroup::~ParPromptGroup() {
     // DON'T delete mGroup! It is owned by mPrompter!
     delete mPrompter;
@@ -72,6 +82,13 @@ namespace hoops {
     return *this;
   }
 
+  ParPromptGroup & ParPromptGroup::operator =(ParPromptGroup && g) noexcept {
+    std::swap(mFile, g.mFile);
+    std::swap(mPrompter, g.mPrompter);
+    std::swap(mGroup, g.mGroup);
+    return *this;
+  }
+
   IParGroup & ParPromptGroup::operator =(const IParGroup & g) {
     *mGroup = g;
     return *this;
@@ -111,6 +128,10 @@ namespace hoops {
     return *this;
   }
 
+  unsigned long ParPromptGroup::Generation() const {
+    return mGroup->Generation();
+  }
+
   GenParItor ParPromptGroup::begin() {
     return mGroup->begin();
   }
@@ -0,0 +1,486 @@
+/******************************************************************************
+ *   File name: hoops_bench.cxx                                               *
+ *                                                                            *
+ * Description: Timing comparisons for performance-sensitive hoops paths.     *
+ *                                                                            *
+ *    Language: C++                                                           *
+ *                                                                            *
+ *      Author: hoops package maintainers (see SConscript)                    *
+ *                                                                            *
+ *  Change log: see CVS Change log at the end of the file.                    *
+ ******************************************************************************/
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "hoops/hoops.h"
+#include "hoops/hoops_binding.h"
+#include "hoops/hoops_group.h"
+#include "hoops/hoops_par.h"
+#include "hoops/hoops_par_file.h"
+
+// Keep results observable so the optimizer cannot drop the timed loops.
+static std::size_t sSink = 0;
+
+typedef std::chrono::steady_clock Clock_t;
+
+// Count every heap allocation, so benchmarks can report allocations per operation.
+static std::size_t sNumAlloc = 0;
+
+void * operator new(std::size_t size) {
+  ++sNumAlloc;
+  void * p = std::malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void * p) noexcept { std::free(p); }
+
+void operator delete(void * p, std::size_t) noexcept { std::free(p); }
+
+static double NanoSecondsPerOp(Clock_t::time_point start, Clock_t::time_point stop, std::size_t num_op) {
+  return std::chrono::duration<double, std::nano>(stop - start).count() / num_op;
+}
+
+static std::string ParName(std::size_t index) {
+  std::ostringstream os;
+  os << "pipeline_par_" << index;
+  return os.str();
+}
+
+// Linear scan of the parameters, i.e. what ParGroup::Find did before it had an index.
+static hoops::IPar & LinearFind(const std::vector<hoops::IPar *> & pars, const std::string & pname) {
+  std::vector<hoops::IPar *>::const_iterator it;
+  for (it = pars.begin(); it != pars.end(); ++it)
+    if (!pname.compare((*it)->Name())) break;
+  if (it == pars.end()) throw hoops::Hexception(hoops::PAR_NOT_FOUND, pname, __FILE__, __LINE__);
+  return *(*it);
+}
+
+static void BenchGroupFind() {
+  using namespace hoops;
+  static const std::size_t num_pars[] = { 10, 100, 1000 };
+  static const std::size_t num_lookup = 1000000;
+
+  std::cout << "ParGroup::Find, " << num_lookup << " lookups:" << std::endl;
+  for (std::size_t ii = 0; ii != sizeof(num_pars) / sizeof(num_pars[0]); ++ii) {
+    ParGroup group("bench");
+    std::vector<std::string> names;
+    for (std::size_t jj = 0; jj != num_pars[ii]; ++jj) {
+      names.push_back(ParName(jj));
+      group.Add(new Par(names.back(), "r", "h", "1."));
+    }
+
+    std::vector<IPar *> pars;
+    for (GenParItor it = group.begin(); it != group.end(); ++it) pars.push_back(*it);
+
+    Clock_t::time_point start = Clock_t::now();
+    for (std::size_t jj = 0; jj != num_lookup; ++jj)
+      sSink += LinearFind(pars, names[jj % names.size()]).Name().size();
+    double linear = NanoSecondsPerOp(start, Clock_t::now(), num_lookup);
+
+    start = Clock_t::now();
+    for (std::size_t jj = 0; jj != num_lookup; ++jj)
+      sSink += group.Find(names[jj % names.size()]).Name().size();
+    double indexed = NanoSecondsPerOp(start, Clock_t::now(), num_lookup);
+
+    std::vector<ParHandle> handles;
+    for (std::size_t jj = 0; jj != names.size(); ++jj) handles.push_back(ParHandle(group, names[jj]));
+    start = Clock_t::now();
+    for (std::size_t jj = 0; jj != num_lookup; ++jj)
+      sSink += handles[jj % handles.size()]->Name().size();
+    double handle = NanoSecondsPerOp(start, Clock_t::now(), num_lookup);
+
+    std::cout << "  " << std::setw(5) << num_pars[ii] << " parameters: linear " << std::setw(9) << linear <<
+      " ns, indexed " << std::setw(9) << indexed << " ns, handle " << std::setw(9) << handle << " ns" << std::endl;
+  }
+}
+
+static void BenchGroupIterate() {
+  using namespace hoops;
+  static const std::size_t num_pars = 1000;
+  static const std::size_t num_pass = 10000;
+
+  ParGroup group("bench");
+  for (std::size_t ii = 0; ii != num_pars; ++ii) group.Add(new Par(ParName(ii), "r", "h", "1."));
+  const ParGroup & const_group = group;
+
+  std::size_t num_alloc = sNumAlloc;
+  Clock_t::time_point start = Clock_t::now();
+  for (std::size_t ii = 0; ii != num_pass; ++ii)
+    for (ConstGenParItor it = const_group.begin(); it != const_group.end(); ++it) sSink += (*it)->Status();
+  double generic = NanoSecondsPerOp(start, Clock_t::now(), num_pass) / 1000.;
+  double generic_alloc = double(sNumAlloc - num_alloc) / num_pass;
+
+  num_alloc = sNumAlloc;
+  start = Clock_t::now();
+  for (std::size_t ii = 0; ii != num_pass; ++ii)
+    for (const IPar & par : const_group.Pars()) sSink += par.Status();
+  double range = NanoSecondsPerOp(start, Clock_t::now(), num_pass) / 1000.;
+  double range_alloc = double(sNumAlloc - num_alloc) / num_pass;
+
+  std::cout << "ParGroup iteration, " << num_pars << " parameters, " << num_pass << " passes:" << std::endl;
+  std::cout << "  ConstGenParItor " << std::setw(9) << generic << " us, " << std::setw(7) << generic_alloc <<
+    " allocations; Pars() " << std::setw(9) << range << " us, " << std::setw(7) << range_alloc << " allocations" <<
+    std::endl;
+}
+
+static void BenchParAssign() {
+  using namespace hoops;
+  static const std::size_t num_assign = 1000000;
+
+  Par ipar("ipar", "i", "h", "0");
+  Par rpar("rpar", "r", "h", "0.");
+
+  Clock_t::time_point start = Clock_t::now();
+  for (std::size_t ii = 0; ii != num_assign; ++ii) ipar = long(ii);
+  double int_assign = NanoSecondsPerOp(start, Clock_t::now(), num_assign);
+
+  start = Clock_t::now();
+  for (std::size_t ii = 0; ii != num_assign; ++ii) rpar = double(ii);
+  double real_assign = NanoSecondsPerOp(start, Clock_t::now(), num_assign);
+  sSink += ipar.Value().size() + rpar.Value().size();
+
+  // Strings too long for the small-string buffer, as for file names.
+  Par spar("spar", "f", "h", "");
+  const std::string path(64, 'p');
+  start = Clock_t::now();
+  for (std::size_t ii = 0; ii != num_assign; ++ii) { std::string value(path); spar = value; }
+  double string_copy = NanoSecondsPerOp(start, Clock_t::now(), num_assign);
+
+  start = Clock_t::now();
+  for (std::size_t ii = 0; ii != num_assign; ++ii) { std::string value(path); spar = std::move(value); }
+  double string_move = NanoSecondsPerOp(start, Clock_t::now(), num_assign);
+  sSink += spar.Value().size();
+
+  std::cout << "Par assignment, " << num_assign << " assignments:" << std::endl;
+  std::cout << "  long to i " << std::setw(9) << int_assign << " ns, double to r " << std::setw(9) << real_assign <<
+    " ns" << std::endl;
+  std::cout << "  string to f, copied " << std::setw(9) << string_copy << " ns, moved " << std::setw(9) <<
+    string_move << " ns" << std::endl;
+}
+
+static void BenchParGetSet() {
+  using namespace hoops;
+  static const std::size_t num_op = 1000000;
+
+  Par rpar("rpar", "r", "h", "0.");
+  const IPar & ipar = rpar;
+
+  double sum = 0.;
+  Clock_t::time_point start = Clock_t::now();
+  for (std::size_t ii = 0; ii != num_op; ++ii) sum += double(ipar);
+  double virtual_get = NanoSecondsPerOp(start, Clock_t::now(), num_op);
+
+  start = Clock_t::now();
+  for (std::size_t ii = 0; ii != num_op; ++ii) sum += rpar.Get<double>();
+  double direct_get = NanoSecondsPerOp(start, Clock_t::now(), num_op);
+
+  start = Clock_t::now();
+  for (std::size_t ii = 0; ii != num_op; ++ii) rpar.Set(double(ii));
+  double direct_set = NanoSecondsPerOp(start, Clock_t::now(), num_op);
+  sSink += std::size_t(sum);
+
+  // Value() renders the string only when the value has changed since the last call.
+  start = Clock_t::now();
+  for (std::size_t ii = 0; ii != num_op; ++ii) sSink += ipar.Value().size();
+  double repeated_value = NanoSecondsPerOp(start, Clock_t::now(), num_op);
+
+  start = Clock_t::now();
+  for (std::size_t ii = 0; ii != num_op; ++ii) sSink += rpar.Set(double(ii)).Value().size();
+  double changed_value = NanoSecondsPerOp(start, Clock_t::now(), num_op);
+
+  std::cout << "Par read/write of a real, " << num_op << " operations:" << std::endl;
+  std::cout << "  double(IPar &) " << std::setw(9) << virtual_get << " ns, Get<double> " << std::setw(9) <<
+    direct_get << " ns, Set(double) " << std::setw(9) << direct_set << " ns" << std::endl;
+  std::cout << "  Value() " << std::setw(9) << repeated_value << " ns, Set(double) then Value() " << std::setw(9) <<
+    changed_value << " ns" << std::endl;
+}
+
+static void BenchBinding() {
+  using namespace hoops;
+  static const std::size_t num_fill = 100000;
+  static const std::size_t num_field = 20;
+  struct Args { double mV0, mV1, mV2, mV3, mV4, mV5, mV6, mV7, mV8, mV9,
+    mV10, mV11, mV12, mV13, mV14, mV15, mV16, mV17, mV18, mV19; };
+  static double Args::* const sMember[num_field] = { &Args::mV0, &Args::mV1, &Args::mV2, &Args::mV3, &Args::mV4,
+    &Args::mV5, &Args::mV6, &Args::mV7, &Args::mV8, &Args::mV9, &Args::mV10, &Args::mV11, &Args::mV12, &Args::mV13,
+    &Args::mV14, &Args::mV15, &Args::mV16, &Args::mV17, &Args::mV18, &Args::mV19 };
+
+  ParGroup group("bench");
+  std::vector<std::string> names;
+  for (std::size_t ii = 0; ii != num_field; ++ii) {
+    names.push_back(ParName(ii));
+    group.Add(new Par(names.back(), "r", "h", "1."));
+  }
+
+  // Each member is read by name, as tools typically do.
+  Args args = Args();
+  Clock_t::time_point start = Clock_t::now();
+  for (std::size_t ii = 0; ii != num_fill; ++ii) {
+    for (std::size_t jj = 0; jj != num_field; ++jj) args.*sMember[jj] = group[names[jj]];
+    sSink += std::size_t(args.*sMember[ii % num_field]);
+  }
+  double by_name = NanoSecondsPerOp(start, Clock_t::now(), num_fill);
+
+  ParBinding<Args> binding;
+  for (std::size_t ii = 0; ii != num_field; ++ii) binding.Bind(names[ii], sMember[ii]);
+  binding.Resolve(group);
+  start = Clock_t::now();
+  for (std::size_t ii = 0; ii != num_fill; ++ii) {
+    binding.Read(args);
+    sSink += std::size_t(args.*sMember[ii % num_field]);
+  }
+  double bound = NanoSecondsPerOp(start, Clock_t::now(), num_fill);
+
+  std::cout << "Fill a structure of " << num_field << " real parameters, " << num_fill << " fills:" << std::endl;
+  std::cout << "  by name " << std::setw(9) << by_name << " ns, ParBinding " << std::setw(9) << bound << " ns" <<
+    std::endl;
+}
+
+// Time To (throwing errors, and reporting warnings to the WarningSink) and TryTo (status-returning) from one source
+// to one destination type.
+template <typename T>
+static void BenchConvertTo(const hoops::IPrim & src, std::size_t num_op, double & throwing, double & returning) {
+  T dest = T();
+  Clock_t::time_point start = Clock_t::now();
+  for (std::size_t ii = 0; ii != num_op; ++ii) {
+    try {
+      src.To(dest);
+    } catch (const hoops::Hexception & x) {
+      sSink += x.Code();
+    }
+  }
+  throwing += NanoSecondsPerOp(start, Clock_t::now(), num_op);
+
+  start = Clock_t::now();
+  for (std::size_t ii = 0; ii != num_op; ++ii) sSink += src.TryTo(dest);
+  returning += NanoSecondsPerOp(start, Clock_t::now(), num_op);
+}
+
+static void BenchConvertRow(const char * name, const hoops::IPrim & src, std::size_t num_op) {
+  double throwing = 0.;
+  double returning = 0.;
+  BenchConvertTo<bool>(src, num_op, throwing, returning);
+  BenchConvertTo<char>(src, num_op, throwing, returning);
+  BenchConvertTo<signed char>(src, num_op, throwing, returning);
+  BenchConvertTo<short>(src, num_op, throwing, returning);
+  BenchConvertTo<int>(src, num_op, throwing, returning);
+  BenchConvertTo<long>(src, num_op, throwing, returning);
+  BenchConvertTo<unsigned char>(src, num_op, throwing, returning);
+  BenchConvertTo<unsigned short>(src, num_op, throwing, returning);
+  BenchConvertTo<unsigned int>(src, num_op, throwing, returning);
+  BenchConvertTo<unsigned long>(src, num_op, throwing, returning);
+  BenchConvertTo<float>(src, num_op, throwing, returning);
+  BenchConvertTo<double>(src, num_op, throwing, returning);
+  BenchConvertTo<long double>(src, num_op, throwing, returning);
+  BenchConvertTo<std::string>(src, num_op, throwing, returning);
+  std::cout << "  " << std::setw(14) << name << ": To " << std::setw(9) << throwing / 14. << " ns, TryTo " <<
+    std::setw(9) << returning / 14. << " ns" << std::endl;
+}
+
+// Same 14 source types and 14 destination types as hoops_prim_test.
+static void BenchConvertMatrix() {
+  using namespace hoops;
+  static const std::size_t num_op = 20000;
+  PrimFactory factory;
+  const IPrim * src[] = {
+    factory.NewIPrim(true), factory.NewIPrim(char(1)), factory.NewIPrim((signed char)(1)),
+    factory.NewIPrim(short(1)), factory.NewIPrim(int(1)), factory.NewIPrim(long(1)),
+    factory.NewIPrim((unsigned char)(1)), factory.NewIPrim((unsigned short)(1)), factory.NewIPrim(1u),
+    factory.NewIPrim(1ul), factory.NewIPrim(1.f), factory.NewIPrim(1.), factory.NewIPrim(1.L),
+    factory.NewIPrim(std::string("1"))
+  };
+  static const char * const name[] = { "bool", "char", "signed char", "short", "int", "long", "unsigned char",
+    "unsigned short", "unsigned int", "unsigned long", "float", "double", "long double", "std::string" };
+
+  std::cout << "IPrim conversion, mean over 14 destination types, " << num_op << " conversions each:" << std::endl;
+  for (std::size_t ii = 0; ii != sizeof(src) / sizeof(src[0]); ++ii) {
+    BenchConvertRow(name[ii], *src[ii], num_op);
+    delete src[ii];
+  }
+}
+
+// Convert src to a long num_op times, catching any exception. Report = call what() on each exception.
+template <typename Src_t>
+static double TimeTo(const Src_t & src, std::size_t num_op, bool report, double & num_alloc) {
+  long dest = 0;
+  std::size_t alloc_start = sNumAlloc;
+  Clock_t::time_point start = Clock_t::now();
+  for (std::size_t ii = 0; ii != num_op; ++ii) {
+    try {
+      src.To(dest);
+      sSink += dest;
+    } catch (const hoops::Hexception & x) {
+      sSink += report ? x.what()[0] : x.Code();
+    }
+  }
+  double time = NanoSecondsPerOp(start, Clock_t::now(), num_op);
+  num_alloc = double(sNumAlloc - alloc_start) / num_op;
+  return time;
+}
+
+// Throw and catch one exception per conversion, as tools do when a conversion is refused.
+static void BenchThrow() {
+  using namespace hoops;
+  static const std::size_t num_op = 100000;
+  PrimFactory factory;
+  const IPrim * src = factory.NewIPrim(1.5);
+  Par inf_par("inf_par", "r", "h", "INF");
+
+  // Real to integer is a P_PRECISION warning.
+  double warned_alloc = 0.;
+  double warned = TimeTo(*src, num_op, false, warned_alloc);
+  WarningSink::SetThrow(true);
+  double thrown_alloc = 0.;
+  double thrown = TimeTo(*src, num_op, false, thrown_alloc);
+  WarningSink::SetThrow(false);
+
+  double inf_alloc = 0.;
+  double inf = TimeTo(inf_par, num_op, false, inf_alloc);
+  // Callers which report the error pay for the message.
+  double reported_alloc = 0.;
+  double reported = TimeTo(inf_par, num_op, true, reported_alloc);
+  delete src;
+
+  std::cout << "Convert to long with a warning or error, " << num_op << " conversions:" << std::endl;
+  std::cout << "  P_PRECISION to WarningSink " << std::setw(9) << warned << " ns, " << std::setw(4) << warned_alloc <<
+    " allocations; thrown " << std::setw(9) << thrown << " ns, " << std::setw(4) << thrown_alloc << " allocations" <<
+    std::endl;
+  std::cout << "  P_INFINITE thrown " << std::setw(9) << inf << " ns, " << std::setw(4) << inf_alloc <<
+    " allocations; with what() " << std::setw(9) << reported << " ns, " << std::setw(4) << reported_alloc <<
+    " allocations" << std::endl;
+}
+
+static void BenchGroupClone() {
+  using namespace hoops;
+  static const std::size_t num_pars = 500;
+  static const std::size_t num_clone = 1000;
+
+  ParGroup group("bench");
+  for (std::size_t ii = 0; ii != num_pars; ++ii) {
+    std::ostringstream os;
+    os << ii;
+    switch (ii % 3) {
+      case 0: group.Add(new Par(ParName(ii), "b", "h", "yes")); break;
+      case 1: group.Add(new Par(ParName(ii), "i", "h", os.str())); break;
+      default: group.Add(new Par(ParName(ii), "r", "h", os.str() + ".5")); break;
+    }
+  }
+
+  std::size_t num_alloc = sNumAlloc;
+  Clock_t::time_point start = Clock_t::now();
+  for (std::size_t ii = 0; ii != num_clone; ++ii) {
+    IParGroup * clone = group.Clone();
+    sSink += clone->Find(ParName(num_pars - 1)).Name().size();
+    delete clone;
+  }
+  double clone = NanoSecondsPerOp(start, Clock_t::now(), num_clone) / 1000.;
+  double clone_alloc = double(sNumAlloc - num_alloc) / num_clone;
+
+  // Worst case: every parameter of the clone is changed, so each copies its shared body.
+  num_alloc = sNumAlloc;
+  start = Clock_t::now();
+  for (std::size_t ii = 0; ii != num_clone; ++ii) {
+    IParGroup * clone = group.Clone();
+    for (GenParItor it = clone->begin(); it != clone->end(); ++it) (*it)->SetPrompt("changed");
+    delete clone;
+  }
+  double unshare = NanoSecondsPerOp(start, Clock_t::now(), num_clone) / 1000.;
+  double unshare_alloc = double(sNumAlloc - num_alloc) / num_clone;
+
+  std::cout << "ParGroup::Clone, " << num_pars << " numeric parameters, " << num_clone << " clones:" << std::endl;
+  std::cout << "  find one " << std::setw(9) << clone << " us, " << std::setw(7) << clone_alloc <<
+    " allocations; change all " << std::setw(9) << unshare << " us, " << std::setw(7) << unshare_alloc <<
+    " allocations" << std::endl;
+}
+
+// Write a parameter file with num_pars parameters of mixed types, plus comments.
+static void WriteParFile(const std::string & file_name, std::size_t num_pars) {
+  std::ofstream os(file_name.c_str());
+  os << "# Synthetic parameter file for timing." << std::endl;
+  for (std::size_t ii = 0; ii != num_pars; ++ii) {
+    switch (ii % 4) {
+      case 0: os << ParName(ii) << ",b,h,yes,,,\"Boolean parameter\"" << std::endl; break;
+      case 1: os << ParName(ii) << ",i,h," << ii << ",0,,\"Integer parameter\"" << std::endl; break;
+      case 2: os << ParName(ii) << ",r,h," << ii << ".5,,,\"Real parameter\"" << std::endl; break;
+      default: os << ParName(ii) << ",s,h,\"value, " << ii << "\",,,\"String parameter\"" << std::endl;
+               os << "# Comment line" << std::endl; break;
+    }
+  }
+}
+
+static void BenchParFileLoad() {
+  using namespace hoops;
+  static const std::size_t num_pars[] = { 10, 100, 1000 };
+  static const std::size_t num_load = 200;
+  const std::string file_name = "hoops_bench.par";
+
+  std::cout << "Parameter file load, " << num_load << " loads:" << std::endl;
+  for (std::size_t ii = 0; ii != sizeof(num_pars) / sizeof(num_pars[0]); ++ii) {
+    WriteParFile(file_name, num_pars[ii]);
+    HoopsParFile file("hoops_bench", file_name);
+    std::string last_name = ParName(num_pars[ii] - 1);
+
+    std::size_t num_alloc = sNumAlloc;
+    Clock_t::time_point start = Clock_t::now();
+    for (std::size_t jj = 0; jj != num_load; ++jj) {
+      file.Load();
+      sSink += file.Group().Find(last_name).Value().size();
+    }
+    double load = NanoSecondsPerOp(start, Clock_t::now(), num_load) / 1000.;
+    double load_alloc = double(sNumAlloc - num_alloc) / num_load;
+
+    num_alloc = sNumAlloc;
+    start = Clock_t::now();
+    for (std::size_t jj = 0; jj != num_load; ++jj) {
+      ParFileMap map(file_name);
+      sSink += map.Find(last_name)->Value().size();
+    }
+    double map = NanoSecondsPerOp(start, Clock_t::now(), num_load) / 1000.;
+    double map_alloc = double(sNumAlloc - num_alloc) / num_load;
+
+    WriteParCache(file_name, file.Group());
+    ParGroup cached("hoops_bench");
+    start = Clock_t::now();
+    for (std::size_t jj = 0; jj != num_load; ++jj) {
+      if (!ReadParCache(file_name, cached)) throw Hexception(P_UNEXPECTED, "Cache is not fresh", __FILE__, __LINE__);
+      sSink += cached.Find(last_name).Value().size();
+    }
+    double cache = NanoSecondsPerOp(start, Clock_t::now(), num_load) / 1000.;
+    RemoveParCache(file_name);
+
+    std::cout << "  " << std::setw(5) << num_pars[ii] << " parameters: HoopsParFile " << std::setw(9) << load <<
+      " us, " << std::setw(7) << load_alloc << " allocations; ParFileMap " << std::setw(9) << map << " us, " <<
+      std::setw(7) << map_alloc << " allocations; binary cache " << std::setw(9) << cache << " us" << std::endl;
+  }
+  std::remove(file_name.c_str());
+}
+
+int main() {
+  std::cout << std::fixed << std::setprecision(1);
+
+  BenchGroupFind();
+  BenchGroupIterate();
+  BenchParAssign();
+  BenchParGetSet();
+  BenchBinding();
+  BenchConvertMatrix();
+  BenchThrow();
+  BenchGroupClone();
+  BenchParFileLoad();
+
+  return 0 == sSink ? 1 : 0;
+}
+
+/******************************************************************************
+ ******************************************************************************/
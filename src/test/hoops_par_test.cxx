@@ -1,13 +1,22 @@
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <typeinfo>
+#include <vector>
 #include "hoops/hoops.h"
 #include "hoops/hoops_ape.h"
 #include "hoops/hoops_ape_factory.h"
+#include "hoops/hoops_binding.h"
+#include "hoops/hoops_group.h"
 #include "hoops/hoops_par.h"
+#include "hoops/hoops_par_file.h"
+#include "hoops/hoops_par_file_factory.h"
 #include "hoops/hoops_prompt_group.h"
 
 #include "ape/ape_par.h"
@@ -56,6 +65,9 @@ int main(int argc, char * argv[]) {
   code[PAR_NOT_FOUND] = "PAR_NOT_FOUND";
   code[PAR_FILE_CORRUPT] = "PAR_FILE_CORRUPT";
 
+  // The tests check the code of every conversion, so warnings must be thrown.
+  WarningSink::SetThrow(true);
+
   std::cout.precision(32);
   std::cerr.precision(32);
   try {
@@ -747,6 +759,615 @@ int main(int argc, char * argv[]) {
       SetGlobalStatus(P_UNEXPECTED);
     }
 
+    // Test parameter group lookup, including after the group changes.
+    {
+      ParGroup group("group_test");
+      group.Add(new Par("", "", "", "", "", "", "", "# comment"));
+      group.Add(new Par("par_a", "i", "h", "1"));
+      group.Add(new Par("par_b", "i", "h", "2"));
+      group.Add(new Par("par_a", "i", "h", "3"));
+      if (1 != (int) group["par_a"] || 2 != (int) group["par_b"]) {
+        std::cerr << "ERROR: ParGroup::Find did not return the first parameter with a given name" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      group["par_b"].SetName("par_c");
+      if (2 != (int) group["par_c"]) {
+        std::cerr << "ERROR: ParGroup::Find did not find a renamed parameter" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      group.Remove("par_a");
+      try {
+        group["par_a"]; sLine = __LINE__;
+        std::cerr << "ERROR: ParGroup::Find at line " << sLine << " found a removed parameter" << std::endl;
+        SetGlobalStatus(ERROR_UNDETECTED);
+      } catch (const Hexception & x) {
+        if (PAR_NOT_FOUND != x.Code()) {
+          std::cerr << "ERROR: ParGroup::Find threw exception " << code[x.Code()] << ", not " << code[PAR_NOT_FOUND] << std::endl;
+          SetGlobalStatus(ERROR_UNDETECTED);
+        }
+      }
+      ParGroup copy(group);
+      group.Clear();
+      std::string names;
+      for (GenParItor it = copy.begin(); it != copy.end(); ++it) names += (*it)->Name() + ";";
+      if (names.compare(";par_c;") || 2 != (int) copy["par_c"]) {
+        std::cerr << "ERROR: Copy of ParGroup has parameters \"" << names << "\", not \";par_c;\"" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+    }
+
+    // Test lookup after an earlier parameter is renamed to the name of a later one.
+    {
+      ParGroup group("group_test");
+      group.Add(new Par("par_a", "i", "h", "1"));
+      group.Add(new Par("par_b", "i", "h", "2"));
+      if (2 != (int) group["par_b"]) {
+        std::cerr << "ERROR: ParGroup::Find did not find par_b" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      ParGroup copy(group);
+      ParGroup moved(std::move(copy));
+      group["par_a"].SetName("par_b");
+      if (1 != (int) group["par_b"]) {
+        std::cerr << "ERROR: ParGroup::Find did not return the first parameter named par_b after a rename" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      // Renaming a parameter of one group leaves other groups alone, and a moved group still tracks renames.
+      moved["par_b"].SetName("par_c");
+      if (2 != (int) moved["par_c"] || 1 != (int) moved["par_a"] || 1 != (int) group["par_b"]) {
+        std::cerr << "ERROR: ParGroup::Find did not follow renames in each group separately" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+    }
+
+    // Test tracking of modified parameters, which lets Save skip unchanged parameters.
+    {
+      Par par("modified", "i", "h", "1");
+      Par copy(par);
+      if (par.IsModified() || copy.IsModified()) {
+        std::cerr << "ERROR: Newly constructed Par is flagged as modified" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      par = 2;
+      Par modified_copy(par);
+      if (!par.IsModified() || !modified_copy.IsModified() || !Par(static_cast<const IPar &>(par)).IsModified()) {
+        std::cerr << "ERROR: Par assigned a value, or its copy, is not flagged as modified" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      par.SetModified(false);
+      par.SetValue("INDEF");
+      if (!par.IsModified()) {
+        std::cerr << "ERROR: Par assigned an undefined value is not flagged as modified" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      // A thrown warning still stores the value.
+      Par real("modified_real", "r", "h", "INDEF");
+      int thrown = P_OK;
+      try {
+        real = 3;
+      } catch (const Hexception & x) {
+        thrown = x.Code();
+      }
+      if (P_PRECISION != thrown || !real.IsModified() || P_OK != real.Status() || real.Value().compare("3")) {
+        std::cerr << "ERROR: Par assigned a value with a thrown warning is not flagged as modified with value 3, but has "
+          << "value \"" << real.Value() << "\"" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+    }
+
+    // Test classification of parameter types, including types with access letters.
+    {
+      if (PT_BOOL != ParseTypeCode("b") || PT_INT != ParseTypeCode("i") || PT_REAL != ParseTypeCode("r") ||
+        PT_STRING != ParseTypeCode("s") || PT_FILE != ParseTypeCode("fr") || PT_FILE != ParseTypeCode("fw") ||
+        PT_UNKNOWN != ParseTypeCode("") || PT_UNKNOWN != ParseTypeCode("x")) {
+        std::cerr << "ERROR: ParseTypeCode did not classify parameter types correctly" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      Par par("infile", "fr", "a", "in.fits");
+      std::ostringstream os;
+      os << par;
+      if (PT_FILE != par.TypeCode() || os.str().compare("infile,fr,a,\"in.fits\",,,\"\"") ||
+        PT_REAL != par.SetType("r").TypeCode()) {
+        std::cerr << "ERROR: Par with type fr has type code " << par.TypeCode() << " and is written as " <<
+          os.str() << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+    }
+
+    // Test the non-virtual Get/Set access, both for the held type and for converted types.
+    {
+      Par par("rpar", "r", "h", "1.5");
+      par.Set(2.5);
+      double held = par.Get<double>();
+      par.Set(3.f);
+      float converted = par.Get<float>();
+      std::string text = par.Set(std::string("4.25")).Get<std::string>();
+      if (2.5 != held || 3 != converted || text.compare("4.25") || !par.IsModified() || 4.25 != double(par)) {
+        std::cerr << "ERROR: Par::Get/Set produced " << held << ", " << converted << " and " << text << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      par.Set(std::string("INDEF"));
+      try {
+        par.Get<double>();
+        std::cerr << "ERROR: Par::Get did not throw for an undefined value" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      } catch (const Hexception & x) {
+        if (P_UNDEFINED != x.Code()) {
+          std::cerr << "ERROR: Par::Get threw " << x.Code() << " for an undefined value" << std::endl;
+          SetGlobalStatus(P_UNEXPECTED);
+        }
+      }
+      if (2.5 != par.Set(2.5).Get<double>() || P_OK != par.Status()) {
+        std::cerr << "ERROR: Par::Set did not clear the undefined status" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+    }
+
+    // Test that the cached string value follows every change of the value.
+    {
+      Par par("ipar", "i", "h", "7");
+      std::string first = par.Value();
+      par = 8;
+      std::string assigned = par.Value();
+      par.Set(9L);
+      std::string set = par.Value();
+      par.SetValue("INDEF");
+      std::string undefined = par.Value();
+      par.From(10L);
+      const std::string & converted = par;
+      if (first.compare("7") || assigned.compare("8") || set.compare("9") || undefined.compare("INDEF") ||
+        converted.compare("10") || &par.Value() != &converted) {
+        std::cerr << "ERROR: Par::Value() gave " << first << ", " << assigned << ", " << set << ", " << undefined <<
+          " and " << converted << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      par = Par("empty", "i", "h", "");
+      if (!par.Value().empty()) {
+        std::cerr << "ERROR: Par::Value() gave " << par.Value() << " after assigning an empty parameter" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+    }
+
+    // Test handles, which must follow their parameter when the group changes.
+    {
+      ParGroup group("handle_test");
+      group.Add(new Par("threshold", "r", "h", "2.5")).Add(new Par("other", "i", "h", "1"));
+      ParHandle handle(group, "threshold");
+      unsigned long generation = group.Generation();
+      if (2.5 != double(*handle) || handle->Name().compare("threshold")) {
+        std::cerr << "ERROR: ParHandle refers to parameter " << handle->Name() << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      group.Remove("threshold");
+      group.Add(new Par("threshold", "r", "h", "3.5"));
+      if (generation == group.Generation() || 3.5 != double(*handle)) {
+        std::cerr << "ERROR: ParHandle did not find its parameter again after the group changed" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      group.Remove("threshold");
+      try {
+        *handle;
+        std::cerr << "ERROR: ParHandle to a removed parameter did not throw" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      } catch (const Hexception & x) {
+        if (PAR_NOT_FOUND != x.Code()) {
+          std::cerr << "ERROR: ParHandle to a removed parameter threw " << x.Code() << std::endl;
+          SetGlobalStatus(P_UNEXPECTED);
+        }
+      }
+      if (ParGroup("another").Generation() == group.Generation()) {
+        std::cerr << "ERROR: Two parameter groups have the same generation" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+    }
+
+    // Test that copies of a group, whose parameters share values, change independently.
+    {
+      ParGroup group("copy_test");
+      group.Add(new Par("ra", "r", "h", "83.5")).Add(new Par("nbins", "i", "h", "20"));
+      IPar & ra = group["ra"];
+      ParHandle handle(group, "ra");
+      struct Args { long mNumBins; } args = { 25 };
+      ParBinding<Args> binding;
+      binding.Bind("nbins", &Args::mNumBins).Resolve(group);
+      ParGroup copy(group);
+      binding.Write(args);
+      std::unique_ptr<IParGroup> clone(group.Clone());
+      ParGroup assigned("assigned");
+      assigned = static_cast<const IParGroup &>(group);
+      *handle = 84.5;
+      copy["nbins"] = 30;
+      (*clone)["ra"] = 85.5;
+      ra.SetPrompt("Right ascension");
+      if (84.5 != double(group["ra"]) || 25 != int(group["nbins"]) || 83.5 != double(copy["ra"]) ||
+        &ra != &*handle || ra.Prompt() != "Right ascension" || !copy["ra"].Prompt().empty() ||
+        30 != int(copy["nbins"]) || 85.5 != double((*clone)["ra"]) || 83.5 != double(assigned["ra"])) {
+        std::cerr << "ERROR: Copies of a group did not change independently" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      group.Remove("nbins");
+      copy.Add(new Par("extra", "s", "h", "x"));
+      std::ostringstream os;
+      const ParGroup & const_copy = copy;
+      for (ConstGenParItor it = const_copy.begin(); it != const_copy.end(); ++it) os << (*it)->Name() << ' ';
+      if (os.str().compare("ra nbins extra ") || 25 != int((*clone)["nbins"])) {
+        std::cerr << "ERROR: Copy of a group holds parameters " << os.str() << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+    }
+
+    // Test range-for iteration over a group, which must give the same parameters as GenParItor.
+    {
+      static_assert(std::is_trivially_copyable<ParGroup::Range_t::Itor_t>::value,
+        "ParGroup range iterators must be trivially copyable");
+      ParGroup group("range_test");
+      group.Add(new Par("ra", "r", "h", "83.5")).Add(new Par("nbins", "i", "h", "20"));
+      ParGroup copy(group);
+      for (IPar & par : copy.Pars()) par.SetModified(true);
+      std::ostringstream os;
+      const ParGroup & const_group = group;
+      ParGroup::ConstRange_t::Itor_t range_it = const_group.Pars().begin();
+      for (ConstGenParItor it = const_group.begin(); it != const_group.end(); ++it, ++range_it)
+        if (*it != &*range_it) os << (*it)->Name() << ' ';
+      if (!os.str().empty() || range_it != const_group.Pars().end() || group["ra"].IsModified() ||
+        !copy["nbins"].IsModified()) {
+        std::cerr << "ERROR: Range-for iteration over a group differs from GenParItor for " << os.str() << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+    }
+
+    // Test moves, which must take over storage rather than copy it.
+    {
+      static_assert(std::is_nothrow_move_constructible<Par>::value && std::is_nothrow_move_constructible<ParGroup>::value &&
+        std::is_nothrow_move_constructible<GenParItor>::value && std::is_nothrow_move_constructible<HoopsApeFile>::value,
+        "hoops types must have noexcept move constructors");
+      std::string long_value(100, 'x');
+      const char * buffer = long_value.data();
+      Par par("infile", "f", "a", "");
+      par = std::move(long_value);
+      Par moved(std::move(par));
+      ParGroup group("move_test");
+      group.Add(new Par(moved)).Add(new Par("nbins", "i", "h", "20"));
+      ParGroup moved_group(std::move(group));
+      GenParItor it;
+      it = moved_group.begin();
+      const PrimUnion * held = dynamic_cast<const PrimUnion *>(moved.PrimValue());
+      const std::string * held_value = 0 != held ? held->GetIf<std::string>() : 0;
+      if (0 == held_value || buffer != held_value->data() || moved_group.begin() == moved_group.end() ||
+        group.begin() != group.end() || (*it)->Name().compare("infile") || 20 != int(moved_group["nbins"])) {
+        std::cerr << "ERROR: Moving a string, Par or ParGroup copied or lost it" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+    }
+
+    // Test the text of exceptions, which is formatted only when asked for.
+    {
+      std::string message = Hexception(P_PRECISION, "", "file.cxx", 12).what();
+      std::string expected = "hoops: attempt to convert from integral to floating type or vice versa (at file.cxx: 12)";
+      std::string given = Hexception(PAR_NOT_FOUND, std::string("Parameter nbins not found")).Msg();
+      std::string ape = ApeException(9, "Cannot open file", "file.cxx").what();
+      std::string file_name("named.cxx");
+      std::string named = Hexception(PAR_NOT_FOUND, "Not found", file_name, 3).what();
+      file_name.clear();
+      // A message in a buffer must be copied, since the buffer may be gone before what() is called.
+      std::string buffered;
+      {
+        char buf[] = "Buffered message";
+        Hexception x(PAR_NOT_FOUND, buf);
+        std::strcpy(buf, "Overwritten");
+        buffered = x.what();
+      }
+      if (buffered != "Buffered message") {
+        std::cerr << "ERROR: Exception text is \"" << buffered << "\", not \"Buffered message\"" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      if (message != expected || given != "Parameter nbins not found" || named != "Not found (at named.cxx: 3)" ||
+        ape != "Cannot open file; Ape exception code 9 (at file.cxx)") {
+        std::cerr << "ERROR: Exception text is \"" << message << "\", \"" << given << "\" and \"" << ape <<
+          "\", not \"" << expected << "\", \"Parameter nbins not found\" and " <<
+          "\"Cannot open file; Ape exception code 9 (at file.cxx)\"" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+    }
+
+    // Test the default handling of conversion warnings, in a new thread since settings are per-thread.
+    {
+      struct Handler {
+        static void Record(int code, void * data) { static_cast<std::vector<int> *>(data)->push_back(code); }
+      };
+      bool throws = true;
+      int value = 0;
+      int thrown = P_OK;
+      unsigned long num_precision = 0;
+      std::vector<int> handled;
+      unsigned long main_num_precision = WarningSink::Count(P_PRECISION);
+      std::thread thread([&]() {
+        throws = WarningSink::Throws();
+        WarningSink::SetHandler(&Handler::Record, &handled);
+        Par par("par_real", "r", "h", "2.5");
+        value = par;
+        par = 7u;
+        try {
+          par = "seven";
+        } catch (const Hexception & x) {
+          thrown = x.Code();
+        }
+        num_precision = WarningSink::Count(P_PRECISION);
+      });
+      thread.join();
+      if (throws || 2 != value || P_STR_INVALID != thrown || 2 != num_precision || 2 != handled.size() ||
+        P_PRECISION != handled[0] || P_PRECISION != handled[1] ||
+        main_num_precision != WarningSink::Count(P_PRECISION)) {
+        std::cerr << "ERROR: By default, conversion warnings were not reported to the WarningSink of their thread " <<
+          "instead of thrown" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+    }
+
+    // Test CatchCode, used by the default Try members, which must return warnings and keep the setting.
+    {
+      WarningSink::SetThrow(false);
+      Par par("par_real", "r", "h", "2.5");
+      int value = 0;
+      HexceptionCode_e status = CatchCode([&]() { par.To(value); });
+      bool throws = WarningSink::Throws();
+      WarningSink::SetThrow(true);
+      if (P_PRECISION != status || 2 != value || throws) {
+        std::cerr << "ERROR: CatchCode returned " << code[status] << ", not P_PRECISION, or changed the warning setting" <<
+          std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+    }
+
+    // Test that threads reading snapshots of a shared group always see a consistent version.
+    {
+      ParGroup group("shared_test");
+      group.Add(new Par("first", "i", "h", "0")).Add(new Par("second", "i", "h", "0"));
+      SharedParGroup shared(group);
+      SharedParGroup::Snapshot_t original = shared.Snapshot();
+      static const long num_update = 2000;
+      std::vector<long> num_inconsistent(4, 0);
+      std::vector<std::thread> readers;
+      for (std::size_t ii = 0; ii != num_inconsistent.size(); ++ii) {
+        readers.push_back(std::thread([&shared, &num_inconsistent, ii]() {
+          for (long jj = 0; jj != num_update; ++jj) {
+            SharedParGroup::Snapshot_t snapshot = shared.Snapshot();
+            if (long(snapshot["first"]) != long(snapshot["second"]) ||
+              snapshot.Find("first").Value() != snapshot.Find("second").Value()) ++num_inconsistent[ii];
+          }
+        }));
+      }
+      for (long ii = 1; ii <= num_update; ++ii)
+        shared.Update([ii](ParGroup & next) { next["first"] = ii; next["second"] = ii; });
+      for (std::size_t ii = 0; ii != readers.size(); ++ii) readers[ii].join();
+      for (std::size_t ii = 0; ii != num_inconsistent.size(); ++ii) {
+        if (0 != num_inconsistent[ii]) {
+          std::cerr << "ERROR: Reader " << ii << " saw " << num_inconsistent[ii] << " inconsistent snapshots" << std::endl;
+          SetGlobalStatus(P_UNEXPECTED);
+        }
+      }
+      static_assert(std::is_same<decltype(original["first"]), const IPar &>::value,
+        "Snapshots must give read-only access to parameters");
+      long sum = 0;
+      for (const IPar & par : original.Pars()) sum += long(par);
+      if (0 != long(original["first"]) || 0 != sum || num_update != long(shared.Snapshot()["second"])) {
+        std::cerr << "ERROR: SharedParGroup snapshots did not keep their versions" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+    }
+
+    // Test binding a group's parameters to the members of a structure.
+    {
+      struct Args { double mRa; int mNumBins; bool mClobber; std::string mInFile; };
+      ParGroup group("binding_test");
+      group.Add(new Par("ra", "r", "a", "83.5")).Add(new Par("nbins", "i", "h", "20"));
+      group.Add(new Par("clobber", "b", "h", "yes")).Add(new Par("infile", "f", "a", "in.fits"));
+      ParBinding<Args> binding;
+      binding.Bind("ra", &Args::mRa).Bind("nbins", &Args::mNumBins).Bind("clobber", &Args::mClobber);
+      binding.Bind("infile", &Args::mInFile);
+      try {
+        Args args = Args();
+        binding.Read(args);
+        std::cerr << "ERROR: ParBinding::Read did not throw before Resolve" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      } catch (const Hexception &) {}
+
+      Args args = Args();
+      binding.Resolve(group).Read(args);
+      if (83.5 != args.mRa || 20 != args.mNumBins || !args.mClobber || args.mInFile.compare("in.fits")) {
+        std::cerr << "ERROR: ParBinding::Read produced " << args.mRa << ", " << args.mNumBins << ", " <<
+          args.mClobber << ", " << args.mInFile << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      args.mRa = 1.25;
+      args.mNumBins = 7;
+      args.mInFile = "out.fits";
+      binding.Write(args);
+      if (1.25 != double(group["ra"]) || 7 != int(group["nbins"]) || group["infile"].Value().compare("out.fits")) {
+        std::cerr << "ERROR: ParBinding::Write produced " << group["ra"].Value() << ", " << group["nbins"].Value() <<
+          ", " << group["infile"].Value() << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      try {
+        ParBinding<Args>().Bind("absent", &Args::mRa).Resolve(group);
+        std::cerr << "ERROR: ParBinding::Resolve did not throw for a missing parameter" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      } catch (const Hexception & x) {
+        if (PAR_NOT_FOUND != x.Code()) {
+          std::cerr << "ERROR: ParBinding::Resolve threw " << x.Code() << " for a missing parameter" << std::endl;
+          SetGlobalStatus(P_UNEXPECTED);
+        }
+      }
+    }
+
+    // Test that 64 bit integer parameters keep every digit, through the
+    // conversions, the binary format and a binding.
+    {
+      const long long event_id = 9007199254740993LL; // 2^53 + 1, which double cannot hold.
+      ParGroup group("int64_test");
+      group.Add(new Par("event_id", "i", "h", "9007199254740993")).Add(new Par("tstart", "i", "h", "0"));
+      // Integer parameters are signed, so this is the largest value they hold.
+      group["tstart"] = 9223372036854775807LL;
+      try {
+        group["tstart"] = 9223372036854775808ULL;
+        std::cerr << "ERROR: Assigning 2^63 to an integer parameter did not throw" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      } catch (const Hexception & x) {
+        if (P_OVERFLOW != x.Code()) {
+          std::cerr << "ERROR: Assigning 2^63 to an integer parameter threw " << x.Code() << std::endl;
+          SetGlobalStatus(P_UNEXPECTED);
+        }
+      }
+      Par & par = static_cast<Par &>(group["event_id"]);
+      if (event_id != par.Get<long long>() || event_id != (long long) par ||
+        9223372036854775807LL != (long long) group["tstart"] ||
+        group["tstart"].Value().compare("9223372036854775807")) {
+        std::cerr << "ERROR: 64 bit integer parameters hold " << par.Value() << " and " << group["tstart"].Value() <<
+          std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      long long negative = -event_id;
+      par = negative;
+      if (par.Value().compare("-9007199254740993")) {
+        std::cerr << "ERROR: Assigning " << negative << " to an integer parameter produced " << par.Value() <<
+          std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+
+      std::ostringstream os;
+      WriteBinary(os, group);
+      ParGroup read("int64_read");
+      std::string buf = os.str();
+      ReadBinary(buf.data(), buf.data() + buf.size(), read);
+      struct Times { long long mEventId; long long mTStart; };
+      Times times = Times();
+      ParBinding<Times>().Bind("event_id", &Times::mEventId).Bind("tstart", &Times::mTStart).Resolve(read).Read(times);
+      if (negative != times.mEventId || 9223372036854775807LL != times.mTStart) {
+        std::cerr << "ERROR: 64 bit integer parameters were read back from binary as " << times.mEventId << " and " <<
+          times.mTStart << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+    }
+
+    // Test the native parameter file, and that it reproduces the file when saved.
+    {
+      IParFile * native = HoopsParFileFactory().NewIParFile("hoops_par_test");
+      const IParGroup & group = native->Group();
+      if (true != (bool) group["test_bool"] || group["test_int"].Max().compare("5") ||
+        group["test_fname"].Value().compare("fakefile.fits") ||
+        group["test_string"].Value().compare("A test # string") ||
+        group["test_hidden"].Prompt().compare("A hidden parameter prompt") || group["mode"].Value().compare("ql")) {
+        std::cerr << "ERROR: HoopsParFile did not load the expected parameters from hoops_par_test.par" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      std::ostringstream orig;
+      for (ConstGenParItor it = group.begin(); it != group.end(); ++it) orig << *(*it) << std::endl;
+
+      const char * copy_name = "hoops_par_test_copy.par";
+      HoopsParFile copy(*static_cast<HoopsParFile *>(native));
+      copy.SetFileName(copy_name);
+      copy.Group()["test_int"] = 3;
+      copy.Group()["test_int"] = 0;
+      copy.Save();
+      if (copy.Group()["test_int"].IsModified()) {
+        std::cerr << "ERROR: HoopsParFile::Save did not mark parameters as unmodified" << std::endl;
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      copy.Group().Clear();
+      copy.Load();
+      std::ostringstream reloaded;
+      for (GenParItor it = copy.begin(); it != copy.end(); ++it) reloaded << *(*it) << std::endl;
+      {
+        ParFileMap map(copy_name);
+        const ParLineView * line = map.Find("test_string");
+        if (0 == line || line->Value() != "A test # string" || line->Prompt() != "Test string parameter" ||
+          0 != map.Find("no_such_par") || 16 != map.size()) {
+          std::cerr << "ERROR: ParFileMap did not find the expected fields in " << copy_name << std::endl;
+          SetGlobalStatus(P_UNEXPECTED);
+        }
+      }
+
+      // Test the binary cache of the file, which must be ignored once the file changes.
+      {
+        WriteParCache(copy_name, copy.Group());
+        ParGroup cached("cached");
+        bool fresh = ReadParCache(copy_name, cached);
+        std::ostringstream from_cache;
+        for (GenParItor it = cached.begin(); it != cached.end(); ++it) from_cache << *(*it) << std::endl;
+        if (!fresh || orig.str() != from_cache.str() || 0. != (double) cached["test_real"] ||
+          cached["test_real"].IsModified()) {
+          std::cerr << "ERROR: ReadParCache did not read back the group written by WriteParCache" << std::endl;
+          SetGlobalStatus(P_UNEXPECTED);
+        }
+        copy.Group()["test_int"] = 3;
+        copy.Save();
+        if (ReadParCache(copy_name, cached) || 0 != (int) cached["test_int"]) {
+          std::cerr << "ERROR: ReadParCache used a cache which is older than its parameter file" << std::endl;
+          SetGlobalStatus(P_UNEXPECTED);
+        }
+        RemoveParCache(copy_name);
+      }
+
+      // Test the cache of a user and a system file, which must be ignored once either changes.
+      {
+        const char * sys_name = "hoops_par_test_sys.par";
+        copy.SetFileName(sys_name);
+        copy.Save();
+        std::vector<std::string> par_files;
+        par_files.push_back(copy_name);
+        par_files.push_back(sys_name);
+        WriteParCache(par_files, copy.Group());
+        ParGroup cached("cached");
+        bool fresh = ReadParCache(par_files, cached);
+        copy.Group()["test_int"] = 4;
+        copy.Save();
+        if (!fresh || ReadParCache(par_files, cached)) {
+          std::cerr << "ERROR: ReadParCache did not key the cache on both the user and the system file" << std::endl;
+          SetGlobalStatus(P_UNEXPECTED);
+        }
+        RemoveParCache(par_files);
+        std::remove(sys_name);
+        copy.SetFileName(copy_name);
+      }
+
+      // Test locating the user and the system file.
+      {
+        const char * pfiles = std::getenv("PFILES");
+        std::string saved_pfiles(0 != pfiles ? pfiles : "");
+        setenv("PFILES", "no_such_dir;.", 1);
+        std::vector<std::string> sys_only = LocateParFiles("hoops_par_test");
+        setenv("PFILES", ".:no_such_dir;no_such_dir:.", 1);
+        std::vector<std::string> both = LocateParFiles("hoops_par_test");
+        if (0 != pfiles) setenv("PFILES", saved_pfiles.c_str(), 1); else unsetenv("PFILES");
+        if (1 != sys_only.size() || sys_only[0] != "./hoops_par_test.par" || 1 != both.size() ||
+          both[0] != "./hoops_par_test.par") {
+          std::cerr << "ERROR: LocateParFiles did not find the user and system files in PFILES" << std::endl;
+          SetGlobalStatus(P_UNEXPECTED);
+        }
+      }
+      // Test that a HoopsApeFile saves a group assigned from another file, whose parameters are unmodified.
+      {
+        HoopsParFile loaded("hoops_par_test", copy_name);
+        HoopsApeFile ape("hoops_par_test");
+        int orig_int = ape.Group()["test_int"];
+        ape = loaded;
+        ape.Save();
+        HoopsApeFile saved("hoops_par_test");
+        if (3 != (int) saved.Group()["test_int"]) {
+          std::cerr << "ERROR: HoopsApeFile::Save did not write a group assigned from a HoopsParFile" << std::endl;
+          SetGlobalStatus(P_UNEXPECTED);
+        }
+        saved.Group()["test_int"] = orig_int;
+        saved.Save();
+      }
+      std::remove(copy_name);
+      if (orig.str() != reloaded.str()) {
+        std::cerr << "ERROR: HoopsParFile after Save and Load contains:\n" << reloaded.str() << "not:\n" << orig.str();
+        SetGlobalStatus(P_UNEXPECTED);
+      }
+      delete native;
+    }
+
     IParFile * file = HoopsApeFileFactory().NewIParFile("hoops_par_test");
 
     file->Load();
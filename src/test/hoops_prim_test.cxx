@@ -3,6 +3,7 @@
 #include <string>
 #include "hoops/hoops.h"
 #include "hoops/hoops_limits.h"
+#include "hoops/hoops_prim.h"
 
 static int sStatus = hoops::P_OK;
 static const int ERROR_UNDETECTED =  + 1;
@@ -16,6 +17,89 @@ int SetGlobalStatus (int status) {
   return sStatus;
 }
 
+// Compare the code returned by TryTo with the code thrown by To.
+template <typename T>
+void CheckTryTo(const hoops::IPrim * prim, const char * name, const char * const * code) {
+  using namespace hoops;
+  T thrown_value = T();
+  T returned_value = T();
+  int thrown = P_OK;
+  try {
+    prim->To(thrown_value);
+  } catch (const Hexception & x) {
+    thrown = x.Code();
+  }
+  int returned = prim->TryTo(returned_value);
+  if (thrown != returned || !(thrown_value == returned_value)) {
+    SetGlobalStatus(P_UNEXPECTED);
+    std::cerr << "ERROR: " << name << "->TryTo returned code " << code[returned] << ", but To threw code " <<
+      code[thrown] << std::endl;
+  }
+}
+
+void CheckTryToAll(const hoops::IPrim * prim, const char * name, const char * const * code) {
+  CheckTryTo<bool>(prim, name, code);
+  CheckTryTo<char>(prim, name, code);
+  CheckTryTo<signed char>(prim, name, code);
+  CheckTryTo<short>(prim, name, code);
+  CheckTryTo<int>(prim, name, code);
+  CheckTryTo<long>(prim, name, code);
+  CheckTryTo<long long>(prim, name, code);
+  CheckTryTo<unsigned char>(prim, name, code);
+  CheckTryTo<unsigned short>(prim, name, code);
+  CheckTryTo<unsigned int>(prim, name, code);
+  CheckTryTo<unsigned long>(prim, name, code);
+  CheckTryTo<unsigned long long>(prim, name, code);
+  CheckTryTo<float>(prim, name, code);
+  CheckTryTo<double>(prim, name, code);
+  CheckTryTo<long double>(prim, name, code);
+  CheckTryTo<std::string>(prim, name, code);
+}
+
+// Assign src to a PrimUnion and to the factory's Prim of the same type, and
+// compare the codes and the resulting values.
+template <typename T, typename S>
+void CheckPrimUnion(hoops::PrimUnion::Type_e type, const S & src, const char * name, const char * const * code) {
+  using namespace hoops;
+  PrimUnion prim_union(type);
+  IPrim * prim = PrimFactory().NewIPrim(T());
+  int union_code = prim_union.TryFrom(src);
+  int prim_code = prim->TryFrom(src);
+  if (union_code != prim_code || prim_union.StringData() != prim->StringData()) {
+    SetGlobalStatus(P_UNEXPECTED);
+    std::cerr << "ERROR: PrimUnion assigned " << name << " returned code " << code[union_code] << " and holds " <<
+      prim_union.StringData() << ", but Prim returned code " << code[prim_code] << " and holds " <<
+      prim->StringData() << std::endl;
+  }
+  CheckTryToAll(&prim_union, name, code);
+  delete prim;
+}
+
+template <typename S>
+void CheckPrimUnionAll(const S & src, const char * name, const char * const * code) {
+  using namespace hoops;
+  CheckPrimUnion<bool>(PrimUnion::eBool, src, name, code);
+  CheckPrimUnion<PrimUnion::Long_t>(PrimUnion::eLong, src, name, code);
+  CheckPrimUnion<double>(PrimUnion::eDouble, src, name, code);
+  CheckPrimUnion<std::string>(PrimUnion::eString, src, name, code);
+}
+
+// Convert value to a string and back, and confirm the same value results.
+template <typename T>
+void CheckRoundTrip(const T & value, const char * name) {
+  using namespace hoops;
+  IPrim * prim = PrimFactory().NewIPrim(value);
+  std::string text = prim->StringData();
+  T result = T();
+  IPrim * read = PrimFactory().NewIPrim(text);
+  if (P_OK != read->TryTo(result) || !(result == value)) {
+    SetGlobalStatus(P_UNEXPECTED);
+    std::cerr << "ERROR: " << name << " was written as " << text << ", which was read back as " << result << std::endl;
+  }
+  delete read;
+  delete prim;
+}
+
 int main() {
   using namespace hoops;
   const char *code[1024];
@@ -34,6 +118,9 @@ int main() {
   code[P_UNEXPECTED] = "P_UNEXPECTED";
   code[ERROR_UNDETECTED] = "ERROR_UNDETECTED";
 
+  // The tests check the code of every conversion, so warnings must be thrown.
+  WarningSink::SetThrow(true);
+
   std::cout.precision(32);
   std::cerr.precision(32);
 
@@ -35691,6 +35778,157 @@ int main() {
       std::cerr << "ERROR: While converting from 0.L, hd_prim_double->From(tmp_long_double) returned incorrect code " << code[x.Code()] << std::endl;
     }
 
+    // The status-returning conversions must agree with the throwing ones.
+    {
+      PrimFactory factory;
+      std::string numeric("-1");
+      IPrim * hd_prim_numeric_string = factory.NewIPrim(numeric);
+      CheckTryToAll(hd_prim_numeric_string, "hd_prim_numeric_string", code);
+      delete hd_prim_numeric_string;
+    }
+    CheckTryToAll(hd_prim_bool, "hd_prim_bool", code);
+    CheckTryToAll(hd_prim_char, "hd_prim_char", code);
+    CheckTryToAll(hd_prim_signed_char, "hd_prim_signed_char", code);
+    CheckTryToAll(hd_prim_short, "hd_prim_short", code);
+    CheckTryToAll(hd_prim_int, "hd_prim_int", code);
+    CheckTryToAll(hd_prim_long, "hd_prim_long", code);
+    CheckTryToAll(hd_prim_unsigned_char, "hd_prim_unsigned_char", code);
+    CheckTryToAll(hd_prim_unsigned_short, "hd_prim_unsigned_short", code);
+    CheckTryToAll(hd_prim_unsigned_int, "hd_prim_unsigned_int", code);
+    CheckTryToAll(hd_prim_unsigned_long, "hd_prim_unsigned_long", code);
+    CheckTryToAll(hd_prim_float, "hd_prim_float", code);
+    CheckTryToAll(hd_prim_double, "hd_prim_double", code);
+    CheckTryToAll(hd_prim_long_double, "hd_prim_long_double", code);
+    CheckTryToAll(hd_prim_std_string, "hd_prim_std_string", code);
+
+    // The inline PrimUnion used by Par must convert exactly as Prim does.
+    CheckPrimUnionAll(true, "true", code);
+    CheckPrimUnionAll(-1L, "-1L", code);
+    CheckPrimUnionAll(1.e300, "1.e300", code);
+    CheckPrimUnionAll(-1.5f, "-1.5f", code);
+    CheckPrimUnionAll(std::string("-1"), "\"-1\"", code);
+    CheckPrimUnionAll(std::string("yes"), "\"yes\"", code);
+    CheckPrimUnionAll(std::string("1.5e40"), "\"1.5e40\"", code);
+    CheckPrimUnionAll(*hd_prim_unsigned_long, "hd_prim_unsigned_long", code);
+
+    // Floating point values written as strings must read back unchanged.
+    CheckRoundTrip(0.1f, "0.1f");
+    CheckRoundTrip(max_float, "max_float");
+    CheckRoundTrip(min_float, "min_float");
+    CheckRoundTrip(0.1 + 0.2, "0.1 + 0.2");
+    CheckRoundTrip(1. / 3., "1. / 3.");
+    CheckRoundTrip(-2.e9, "-2.e9");
+    CheckRoundTrip(max_double, "max_double");
+    CheckRoundTrip(min_double, "min_double");
+    CheckRoundTrip(1.L / 3.L, "1.L / 3.L");
+    CheckRoundTrip(max_long_double, "max_long_double");
+    CheckRoundTrip(min_long_double, "min_long_double");
+
+    // Strings must be rounded once, straight to float, not by way of double.
+    {
+      PrimFactory factory;
+      struct { const char * mText; int mCode; float mValue; } cases[] = {
+        { "1.00000017881393432617187499", P_OK, 1.00000011920928955078125f },
+        { "1e39", P_OVERFLOW, Lim<float>::max() },
+        { "-1e39", P_UNDERFLOW, -Lim<float>::max() },
+        { "1e-50", P_OK, 0.f },
+        { "1e400", P_STR_OVERFLOW, Lim<float>::max() }
+      };
+      for (std::size_t ii = 0; ii != sizeof(cases) / sizeof(cases[0]); ++ii) {
+        IPrim * prim = factory.NewIPrim(std::string(cases[ii].mText));
+        float value = 1.f;
+        int float_code = prim->TryTo(value);
+        if (cases[ii].mCode != float_code || cases[ii].mValue != value) {
+          SetGlobalStatus(P_UNEXPECTED);
+          std::cerr.precision(10);
+          std::cerr << "ERROR: \"" << cases[ii].mText << "\" converted to float " << value << " with code " <<
+            code[float_code] << ", not " << cases[ii].mValue << " with code " << code[cases[ii].mCode] << std::endl;
+        }
+        delete prim;
+      }
+    }
+
+    // 64 bit integers must convert exactly, and not by way of double.
+    CheckPrimUnionAll(-9007199254740993LL, "-9007199254740993LL", code);
+    CheckPrimUnionAll(Lim<unsigned long long>::max(), "Lim<unsigned long long>::max()", code);
+    CheckPrimUnionAll(std::string("9007199254740993"), "\"9007199254740993\"", code);
+    CheckRoundTrip(Lim<long long>::max(), "Lim<long long>::max()");
+    CheckRoundTrip(Lim<long long>::min(), "Lim<long long>::min()");
+    CheckRoundTrip(Lim<unsigned long long>::max(), "Lim<unsigned long long>::max()");
+    {
+      PrimFactory factory;
+      struct { const char * mText; int mSignedCode; long long mSigned; int mUnsignedCode; unsigned long long mUnsigned; }
+        cases[] = {
+        { "9007199254740993", P_OK, 9007199254740993LL, P_OK, 9007199254740993ULL },
+        { "-9223372036854775808", P_OK, Lim<long long>::min(), P_OK, 9223372036854775808ULL },
+        { "0x7fffffffffffffff", P_OK, Lim<long long>::max(), P_OK, 9223372036854775807ULL },
+        { "9223372036854775808", P_STR_OVERFLOW, Lim<long long>::max(), P_OK, 9223372036854775808ULL },
+        { "18446744073709551616", P_STR_OVERFLOW, Lim<long long>::max(), P_STR_OVERFLOW, Lim<unsigned long long>::max() },
+        { "12x", P_STR_INVALID, 12LL, P_STR_INVALID, 12ULL }
+      };
+      for (std::size_t ii = 0; ii != sizeof(cases) / sizeof(cases[0]); ++ii) {
+        IPrim * prim = factory.NewIPrim(std::string(cases[ii].mText));
+        long long signed_value = 0;
+        unsigned long long unsigned_value = 0;
+        int signed_code = prim->TryTo(signed_value);
+        int unsigned_code = prim->TryTo(unsigned_value);
+        if (cases[ii].mSignedCode != signed_code || cases[ii].mSigned != signed_value) {
+          SetGlobalStatus(P_UNEXPECTED);
+          std::cerr << "ERROR: \"" << cases[ii].mText << "\" converted to long long " << signed_value << " with code " <<
+            code[signed_code] << ", not " << cases[ii].mSigned << " with code " << code[cases[ii].mSignedCode] << std::endl;
+        }
+        if (cases[ii].mUnsignedCode != unsigned_code || cases[ii].mUnsigned != unsigned_value) {
+          SetGlobalStatus(P_UNEXPECTED);
+          std::cerr << "ERROR: \"" << cases[ii].mText << "\" converted to unsigned long long " << unsigned_value <<
+            " with code " << code[unsigned_code] << ", not " << cases[ii].mUnsigned << " with code " <<
+            code[cases[ii].mUnsignedCode] << std::endl;
+        }
+        delete prim;
+      }
+
+      // Strings beyond the range of long give its limit, as they do for long long.
+      {
+        IPrim * prim = factory.NewIPrim(std::string("-99999999999999999999"));
+        long long_value = 0;
+        if (P_STR_OVERFLOW != prim->TryTo(long_value) || Lim<long>::min() != long_value) {
+          SetGlobalStatus(P_UNEXPECTED);
+          std::cerr << "ERROR: \"-99999999999999999999\" converted to long " << long_value << ", not " <<
+            Lim<long>::min() << std::endl;
+        }
+        delete prim;
+      }
+
+      // The defaults in IPrim and IPrimFactory, for other implementations, go by way of long.
+      {
+        IPrim * signed_prim = factory.IPrimFactory::NewIPrim(7LL);
+        IPrim * unsigned_prim = factory.IPrimFactory::NewIPrim(7ULL);
+        signed_prim->IPrim::From(-5LL);
+        unsigned_prim->IPrim::From(9ULL);
+        long long signed_value = 0;
+        unsigned long long unsigned_value = 0;
+        signed_prim->IPrim::To(signed_value);
+        unsigned_prim->IPrim::To(unsigned_value);
+        if (-5LL != signed_value || 9ULL != unsigned_value) {
+          SetGlobalStatus(P_UNEXPECTED);
+          std::cerr << "ERROR: IPrim converted 64 bit integers by default to " << signed_value << " and " <<
+            unsigned_value << ", not -5 and 9" << std::endl;
+        }
+        delete unsigned_prim;
+        delete signed_prim;
+      }
+
+      // Conversions between 64 bit and narrower types are range checked.
+      IPrim * prim = factory.NewIPrim(Lim<unsigned long long>::max());
+      long long signed_value = 0;
+      int int_value = 0;
+      if (P_OVERFLOW != prim->TryTo(signed_value) || Lim<long long>::max() != signed_value ||
+        P_OVERFLOW != prim->TryTo(int_value) || Lim<int>::max() != int_value) {
+        SetGlobalStatus(P_UNEXPECTED);
+        std::cerr << "ERROR: Lim<unsigned long long>::max() did not overflow long long and int" << std::endl;
+      }
+      delete prim;
+    }
+
   } catch (const Hexception &x) {
     std::cerr << "An unexpected exception " << code[status] << " was caught at the top level!" << std::endl;
     SetGlobalStatus(status);
@@ -56,9 +56,9 @@ int main(int argc, char * argv[]) {
       // The desired value of test_real was destroyed by the
       // bad conversion above, so reset it again to what it was before:
       pars["test_real"] = d;
-      // (This is a feature: hoops converts the value no matter what
-      // in case you want to ignore an exception, e.g. changing
-      // signedness.)
+      // (This is a feature: hoops converts the value no matter what.
+      // Conversions which only warn, e.g. changing signedness, do not
+      // throw at all unless WarningSink::SetThrow(true) is called.)
     }
 
     // If you want to lose the changes you just made, just load